@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// name generation kernels and rename option types, kept free of editor and engine
+// dependencies so they can be linked into small programs such as the benchmark target
+public class LeartesRenameCore : ModuleRules
+{
+	public LeartesRenameCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core"
+			}
+			);
+	}
+}
@@ -0,0 +1,183 @@
+#include "RenameCase.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define RENAME_CASE_SSE2 1
+#define RENAME_CASE_NEON 0
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON && PLATFORM_CPU_ARM_FAMILY && PLATFORM_64BITS
+#include <arm_neon.h>
+#define RENAME_CASE_SSE2 0
+#define RENAME_CASE_NEON 1
+#else
+#define RENAME_CASE_SSE2 0
+#define RENAME_CASE_NEON 0
+#endif
+
+namespace RenameCase
+{
+	// characters per vector block, two registers of eight 16 bit characters
+	static constexpr int32 BlockLen = 16;
+
+	template<bool bUpper>
+	static FORCEINLINE TCHAR ConvertChar(TCHAR C)
+	{
+		if (uint32(C) < 128)
+		{
+			// flip bit 5 of the letters of the other case
+			constexpr uint32 First = bUpper ? 'a' : 'A';
+			return uint32(C) - First < 26u ? TCHAR(C ^ 0x20) : C;
+		}
+		return bUpper ? FChar::ToUpper(C) : FChar::ToLower(C);
+	}
+
+	template<bool bUpper>
+	static void ConvertInPlace(TCHAR* Chars, int32 Len)
+	{
+		int32 i = 0;
+
+#if RENAME_CASE_SSE2 || RENAME_CASE_NEON
+		if constexpr (sizeof(TCHAR) == 2)
+		{
+			constexpr uint16 First = bUpper ? 'a' : 'A';
+			constexpr uint16 Last = bUpper ? 'z' : 'Z';
+#if RENAME_CASE_SSE2
+			const __m128i NonAscii = _mm_set1_epi16(short(0xFF80));
+			const __m128i Zero = _mm_setzero_si128();
+			const __m128i Below = _mm_set1_epi16(short(First - 1));
+			const __m128i Above = _mm_set1_epi16(short(Last + 1));
+			const __m128i Flip = _mm_set1_epi16(0x20);
+			auto Convert = [&](__m128i V)
+			{
+				// only ascii reaches here, so the signed compares are exact
+				const __m128i IsLetter = _mm_and_si128(_mm_cmpgt_epi16(V, Below), _mm_cmplt_epi16(V, Above));
+				return _mm_xor_si128(V, _mm_and_si128(IsLetter, Flip));
+			};
+#else
+			const uint16x8_t FirstV = vdupq_n_u16(First);
+			const uint16x8_t LastV = vdupq_n_u16(Last);
+			const uint16x8_t Flip = vdupq_n_u16(0x20);
+			auto Convert = [&](uint16x8_t V)
+			{
+				const uint16x8_t IsLetter = vandq_u16(vcgeq_u16(V, FirstV), vcleq_u16(V, LastV));
+				return veorq_u16(V, vandq_u16(IsLetter, Flip));
+			};
+#endif
+			for (; i + BlockLen <= Len; i += BlockLen)
+			{
+				TCHAR* Block = Chars + i;
+#if RENAME_CASE_SSE2
+				const __m128i A = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block));
+				const __m128i B = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 8));
+				const bool bAscii = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(A, B), NonAscii), Zero)) == 0xFFFF;
+#else
+				const uint16x8_t A = vld1q_u16(reinterpret_cast<const uint16*>(Block));
+				const uint16x8_t B = vld1q_u16(reinterpret_cast<const uint16*>(Block + 8));
+				const bool bAscii = vmaxvq_u16(vorrq_u16(A, B)) < 128;
+#endif
+				if (!bAscii)
+				{
+					for (int32 j = 0; j < BlockLen; ++j)
+					{
+						Block[j] = ConvertChar<bUpper>(Block[j]);
+					}
+					continue;
+				}
+#if RENAME_CASE_SSE2
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Block), Convert(A));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(Block + 8), Convert(B));
+#else
+				vst1q_u16(reinterpret_cast<uint16*>(Block), Convert(A));
+				vst1q_u16(reinterpret_cast<uint16*>(Block + 8), Convert(B));
+#endif
+			}
+		}
+#endif
+
+		for (; i < Len; ++i)
+		{
+			Chars[i] = ConvertChar<bUpper>(Chars[i]);
+		}
+	}
+
+	void ToUpperInPlace(TCHAR* Chars, int32 Len)
+	{
+		ConvertInPlace<true>(Chars, Len);
+	}
+
+	void ToLowerInPlace(TCHAR* Chars, int32 Len)
+	{
+		ConvertInPlace<false>(Chars, Len);
+	}
+
+	enum class ECharKind : uint8
+	{
+		Separator,
+		Upper,
+		Lower,
+		// digits and everything without case
+		Other
+	};
+
+	static FORCEINLINE ECharKind GetCharKind(TCHAR C)
+	{
+		if (uint32(C) < 128)
+		{
+			if (C == TEXT('_') || C == TEXT('-') || C == TEXT(' ')) return ECharKind::Separator;
+			if (uint32(C) - 'A' < 26u) return ECharKind::Upper;
+			if (uint32(C) - 'a' < 26u) return ECharKind::Lower;
+			return ECharKind::Other;
+		}
+		if (FChar::IsUpper(C)) return ECharKind::Upper;
+		if (FChar::IsLower(C)) return ECharKind::Lower;
+		return ECharKind::Other;
+	}
+
+	int32 ApplyWordStyle(ECaseOp Op, FStringView Name, TCHAR* Dest)
+	{
+		const TCHAR* Chars = Name.GetData();
+		const int32 Len = Name.Len();
+		const bool bSeparate = Op == ECaseOp::SnakeCase || Op == ECaseOp::TitleCase;
+
+		TCHAR* Write = Dest;
+		int32 WordCount = 0;
+		ECharKind Prev = ECharKind::Separator;
+		ECharKind Kind = Len > 0 ? GetCharKind(Chars[0]) : ECharKind::Separator;
+
+		for (int32 i = 0; i < Len; ++i)
+		{
+			const ECharKind NextKind = i + 1 < Len ? GetCharKind(Chars[i + 1]) : ECharKind::Separator;
+			const TCHAR C = Chars[i];
+
+			if (Kind != ECharKind::Separator)
+			{
+				const bool bWordStart = Prev == ECharKind::Separator
+					|| (Kind == ECharKind::Upper && (Prev != ECharKind::Upper || NextKind == ECharKind::Lower));
+
+				if (!bWordStart)
+				{
+					*Write++ = ConvertChar<false>(C);
+				}
+				else
+				{
+					if (bSeparate && WordCount > 0)
+					{
+						*Write++ = TEXT('_');
+					}
+					const bool bLowerFirst = Op == ECaseOp::SnakeCase || (Op == ECaseOp::CamelCase && WordCount == 0);
+					*Write++ = bLowerFirst ? ConvertChar<false>(C) : ConvertChar<true>(C);
+					++WordCount;
+				}
+			}
+
+			Prev = Kind;
+			Kind = NextKind;
+		}
+
+		if (WordCount == 0)
+		{
+			FMemory::Memcpy(Dest, Chars, Len * sizeof(TCHAR));
+			return Len;
+		}
+		return int32(Write - Dest);
+	}
+}
@@ -0,0 +1,134 @@
+#include "RenameNameDiff.h"
+
+// cells of the alignment table, beyond this the middle becomes one replace
+static constexpr int32 MaxDiffCells = 1 << 16;
+
+namespace RenameNameDiff
+{
+	// equal run or change of the middle part, lengths only, starts follow from the order
+	struct FRun
+	{
+		bool bEqual = false;
+		int32 OldLen = 0;
+		int32 NewLen = 0;
+	};
+
+	static void AddRun(TArray<FRun, TInlineAllocator<16>>& Runs, bool bEqual, int32 OldLen, int32 NewLen)
+	{
+		if (Runs.Num() > 0 && Runs.Last().bEqual == bEqual)
+		{
+			Runs.Last().OldLen += OldLen;
+			Runs.Last().NewLen += NewLen;
+		}
+		else
+		{
+			Runs.Add({ bEqual, OldLen, NewLen });
+		}
+	}
+
+	static void Align(FStringView Old, FStringView New, TArray<FRun, TInlineAllocator<16>>& OutRuns)
+	{
+		const int32 N = Old.Len();
+		const int32 M = New.Len();
+		const int32 Stride = M + 1;
+
+		// Lcs[i * Stride + j] is the longest common subsequence of Old[i..] and New[j..]
+		TArray<uint16> Lcs;
+		Lcs.SetNumZeroed((N + 1) * Stride);
+		for (int32 i = N - 1; i >= 0; --i)
+		{
+			for (int32 j = M - 1; j >= 0; --j)
+			{
+				Lcs[i * Stride + j] = Old[i] == New[j]
+					? uint16(Lcs[(i + 1) * Stride + j + 1] + 1)
+					: FMath::Max(Lcs[(i + 1) * Stride + j], Lcs[i * Stride + j + 1]);
+			}
+		}
+
+		int32 i = 0;
+		int32 j = 0;
+		while (i < N || j < M)
+		{
+			if (i < N && j < M && Old[i] == New[j])
+			{
+				AddRun(OutRuns, true, 1, 1);
+				++i;
+				++j;
+			}
+			else if (j == M || (i < N && Lcs[(i + 1) * Stride + j] >= Lcs[i * Stride + j + 1]))
+			{
+				AddRun(OutRuns, false, 1, 0);
+				++i;
+			}
+			else
+			{
+				AddRun(OutRuns, false, 0, 1);
+				++j;
+			}
+		}
+	}
+
+	void Compute(FStringView OldName, FStringView NewName, FRenameNameDiff& OutSpans)
+	{
+		OutSpans.Reset();
+
+		const int32 MaxAffix = FMath::Min(OldName.Len(), NewName.Len());
+		int32 Prefix = 0;
+		while (Prefix < MaxAffix && OldName[Prefix] == NewName[Prefix])
+		{
+			++Prefix;
+		}
+		int32 Suffix = 0;
+		while (Suffix < MaxAffix - Prefix && OldName[OldName.Len() - 1 - Suffix] == NewName[NewName.Len() - 1 - Suffix])
+		{
+			++Suffix;
+		}
+
+		const FStringView OldMiddle = OldName.Mid(Prefix, OldName.Len() - Prefix - Suffix);
+		const FStringView NewMiddle = NewName.Mid(Prefix, NewName.Len() - Prefix - Suffix);
+
+		TArray<FRun, TInlineAllocator<16>> Runs;
+		if (Prefix > 0)
+		{
+			Runs.Add({ true, Prefix, Prefix });
+		}
+		if (OldMiddle.Len() > 0 && NewMiddle.Len() > 0 && (int64(OldMiddle.Len()) + 1) * (NewMiddle.Len() + 1) <= MaxDiffCells)
+		{
+			TArray<FRun, TInlineAllocator<16>> MiddleRuns;
+			Align(OldMiddle, NewMiddle, MiddleRuns);
+
+			// a lone matching character between two changes reads as part of one change
+			for (int32 r = 0; r < MiddleRuns.Num(); ++r)
+			{
+				const FRun& Run = MiddleRuns[r];
+				const bool bLoneMatch = Run.bEqual && Run.OldLen == 1 && r > 0 && r + 1 < MiddleRuns.Num();
+				AddRun(Runs, Run.bEqual && !bLoneMatch, Run.OldLen, Run.NewLen);
+			}
+		}
+		else if (OldMiddle.Len() > 0 || NewMiddle.Len() > 0)
+		{
+			AddRun(Runs, false, OldMiddle.Len(), NewMiddle.Len());
+		}
+		if (Suffix > 0)
+		{
+			AddRun(Runs, true, Suffix, Suffix);
+		}
+
+		int32 OldStart = 0;
+		int32 NewStart = 0;
+		for (const FRun& Run : Runs)
+		{
+			FRenameDiffSpan& Span = OutSpans.AddDefaulted_GetRef();
+			Span.Op = Run.bEqual ? ERenameDiffOp::Equal
+				: Run.NewLen == 0 ? ERenameDiffOp::Remove
+				: Run.OldLen == 0 ? ERenameDiffOp::Insert
+				: ERenameDiffOp::Replace;
+			Span.OldStart = OldStart;
+			Span.OldLen = Run.OldLen;
+			Span.NewStart = NewStart;
+			Span.NewLen = Run.NewLen;
+			OldStart += Run.OldLen;
+			NewStart += Run.NewLen;
+		}
+	}
+}
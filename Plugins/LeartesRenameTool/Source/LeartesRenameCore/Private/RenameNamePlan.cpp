@@ -0,0 +1,246 @@
+#include "RenameNamePlan.h"
+#include "RenameCase.h"
+
+// room for "_", a sign and the widest supported padding
+static constexpr int32 MaxNumberChars = 64;
+
+FRenameNamePlan::FRenameNamePlan(const FRenameOptions& Options)
+	: Prefix(Options.Prefix)
+	, Suffix(Options.Suffix)
+	, ReplaceTable(MakeReplaceTable(Options))
+	, CaseOp(Options.CaseOp)
+	, StartNumber(Options.StartNumber)
+	, Padding(FMath::Clamp(Options.Padding, 1, MaxNumberChars - 2))
+{
+	if (ReplaceTable.Num() > 1)
+	{
+		Automaton = MakeShared<FRenameReplaceAutomaton, ESPMode::ThreadSafe>(ReplaceTable);
+	}
+	if (Options.bFindRegex && !Options.Find.IsEmpty())
+	{
+		Regex = FRenameRegex::Get(Options.Find, Options.Replace, Options.bFindIgnoreCase);
+	}
+
+	const bool bFind = ReplaceTable.Num() > 0 || Regex.IsValid();
+	const bool bCase = CaseOp != ECaseOp::None;
+	const bool bNumber = Options.bUseNumbering;
+
+	// one specialization per combination of active steps, indexed as find|case|number bits
+	static const FGenerateFn Specializations[8] =
+	{
+		&GenerateImpl<false, false, false>,
+		&GenerateImpl<false, false, true>,
+		&GenerateImpl<false, true, false>,
+		&GenerateImpl<false, true, true>,
+		&GenerateImpl<true, false, false>,
+		&GenerateImpl<true, false, true>,
+		&GenerateImpl<true, true, false>,
+		&GenerateImpl<true, true, true>,
+	};
+	GenerateFn = Specializations[(bFind ? 4 : 0) | (bCase ? 2 : 0) | (bNumber ? 1 : 0)];
+}
+
+FRenameNamePlan FRenameNamePlan::BaseStage(const FRenameOptions& Options)
+{
+	FRenameOptions BaseOptions = Options;
+	BaseOptions.Prefix.Reset();
+	BaseOptions.Suffix.Reset();
+	BaseOptions.bUseNumbering = false;
+	return FRenameNamePlan(BaseOptions);
+}
+
+FRenameNamePlan FRenameNamePlan::ComposeStage(const FRenameOptions& Options)
+{
+	FRenameOptions ComposeOptions = Options;
+	ComposeOptions.Find.Reset();
+	ComposeOptions.Replace.Reset();
+	ComposeOptions.ReplaceRules.Reset();
+	ComposeOptions.CaseOp = ECaseOp::None;
+	return FRenameNamePlan(ComposeOptions);
+}
+
+//same output as "_%0*d" with the plan padding
+int32 FRenameNamePlan::FormatNumber(int32 Index, TCHAR* Dest) const
+{
+	const int64 Number = int64(StartNumber) + Index;
+	uint64 Magnitude = Number < 0 ? uint64(-Number) : uint64(Number);
+
+	TCHAR Digits[20];
+	int32 NumDigits = 0;
+	do
+	{
+		Digits[NumDigits++] = TCHAR('0' + Magnitude % 10);
+		Magnitude /= 10;
+	}
+	while (Magnitude != 0);
+
+	TCHAR* Write = Dest;
+	*Write++ = TEXT('_');
+	if (Number < 0)
+	{
+		*Write++ = TEXT('-');
+	}
+
+	// printf counts the sign towards the field width
+	const int32 ZeroCount = Padding - NumDigits - (Number < 0 ? 1 : 0);
+	for (int32 i = 0; i < ZeroCount; ++i)
+	{
+		*Write++ = TEXT('0');
+	}
+	while (NumDigits > 0)
+	{
+		*Write++ = Digits[--NumDigits];
+	}
+
+	return int32(Write - Dest);
+}
+
+TCHAR* FRenameNamePlan::WriteReplaced(const TCHAR* Src, int32 SrcLen, TArrayView<const FRenameReplaceAutomaton::FMatch> Matches, TCHAR* Dest) const
+{
+	int32 Copied = 0;
+	for (const FRenameReplaceAutomaton::FMatch& Match : Matches)
+	{
+		const FRenameReplaceRule& Rule = ReplaceTable[Match.Rule];
+		FMemory::Memcpy(Dest, Src + Copied, (Match.Pos - Copied) * sizeof(TCHAR));
+		Dest += Match.Pos - Copied;
+		FMemory::Memcpy(Dest, *Rule.Replace, Rule.Replace.Len() * sizeof(TCHAR));
+		Dest += Rule.Replace.Len();
+		Copied = Match.Pos + Rule.Find.Len();
+	}
+	FMemory::Memcpy(Dest, Src + Copied, (SrcLen - Copied) * sizeof(TCHAR));
+	return Dest + SrcLen - Copied;
+}
+
+template<bool bFind, bool bCase, bool bNumber>
+void FRenameNamePlan::GenerateImpl(const FRenameNamePlan& Plan, FStringView OldName, int32 Index, FString& Out)
+{
+	const TCHAR* Src = OldName.GetData();
+	int32 SrcLen = OldName.Len();
+
+	// locate the find matches up front (left to right, non overlapping like FString::Replace)
+	// so the final length is known before anything is written
+	FRenameReplaceAutomaton::FMatchArray Matches;
+	FString RegexOut;
+	int32 BaseLen = SrcLen;
+	if constexpr (bFind)
+	{
+		// a regex rewrites the name first, the literal table then scans what it produced
+		if (Plan.Regex.IsValid() && Plan.Regex->Apply(OldName, RegexOut))
+		{
+			Src = *RegexOut;
+			SrcLen = RegexOut.Len();
+			BaseLen = SrcLen;
+		}
+
+		if (Plan.Automaton.IsValid())
+		{
+			Plan.Automaton->FindMatches(FStringView(Src, SrcLen), Matches);
+		}
+		else if (Plan.ReplaceTable.Num() == 1)
+		{
+			const FString& Find = Plan.ReplaceTable[0].Find;
+			const TCHAR* FindChars = *Find;
+			const int32 FindLen = Find.Len();
+			for (int32 Pos = 0; Pos + FindLen <= SrcLen;)
+			{
+				if (Src[Pos] == FindChars[0] && FMemory::Memcmp(Src + Pos, FindChars, FindLen * sizeof(TCHAR)) == 0)
+				{
+					Matches.Add({ Pos, 0 });
+					Pos += FindLen;
+				}
+				else
+				{
+					++Pos;
+				}
+			}
+		}
+
+		for (const FRenameReplaceAutomaton::FMatch& Match : Matches)
+		{
+			const FRenameReplaceRule& Rule = Plan.ReplaceTable[Match.Rule];
+			BaseLen += Rule.Replace.Len() - Rule.Find.Len();
+		}
+	}
+
+	// word styles change the length, so the base name is cased into a scratch buffer up front
+	TArray<TCHAR, TInlineAllocator<256>> Replaced;
+	TArray<TCHAR, TInlineAllocator<256>> Words;
+	bool bWordStyle = false;
+	if constexpr (bCase)
+	{
+		bWordStyle = RenameCase::IsWordStyle(Plan.CaseOp);
+		if (bWordStyle)
+		{
+			if (Matches.Num() > 0)
+			{
+				Replaced.SetNumUninitialized(BaseLen);
+				Plan.WriteReplaced(Src, SrcLen, Matches, Replaced.GetData());
+				Src = Replaced.GetData();
+				SrcLen = BaseLen;
+				Matches.Reset();
+			}
+
+			Words.SetNumUninitialized(RenameCase::MaxWordStyleLen(SrcLen));
+			BaseLen = RenameCase::ApplyWordStyle(Plan.CaseOp, FStringView(Src, SrcLen), Words.GetData());
+			Src = Words.GetData();
+			SrcLen = BaseLen;
+		}
+	}
+
+	TCHAR NumberChars[MaxNumberChars];
+	int32 NumberLen = 0;
+	if constexpr (bNumber)
+	{
+		NumberLen = Plan.FormatNumber(Index, NumberChars);
+	}
+
+	const int32 TotalLen = Plan.Prefix.Len() + BaseLen + NumberLen + Plan.Suffix.Len();
+
+	auto& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(TotalLen + 1, EAllowShrinking::No);
+	TCHAR* Dest = Chars.GetData();
+
+	FMemory::Memcpy(Dest, *Plan.Prefix, Plan.Prefix.Len() * sizeof(TCHAR));
+	Dest += Plan.Prefix.Len();
+
+	TCHAR* Base = Dest;
+	if constexpr (bFind)
+	{
+		Dest = Plan.WriteReplaced(Src, SrcLen, Matches, Dest);
+	}
+	else
+	{
+		FMemory::Memcpy(Dest, Src, SrcLen * sizeof(TCHAR));
+		Dest += SrcLen;
+	}
+
+	// case operations only touch the base name, never prefix, number or suffix
+	if constexpr (bCase)
+	{
+		switch (bWordStyle ? ECaseOp::None : Plan.CaseOp)
+		{
+		case ECaseOp::Upper:
+			RenameCase::ToUpperInPlace(Base, int32(Dest - Base));
+			break;
+		case ECaseOp::Lower:
+			RenameCase::ToLowerInPlace(Base, int32(Dest - Base));
+			break;
+		case ECaseOp::CapitalizeFirst:
+			if (Base < Dest) *Base = FChar::ToUpper(*Base);
+			break;
+		default:
+			break;
+		}
+	}
+
+	if constexpr (bNumber)
+	{
+		FMemory::Memcpy(Dest, NumberChars, NumberLen * sizeof(TCHAR));
+		Dest += NumberLen;
+	}
+
+	FMemory::Memcpy(Dest, *Plan.Suffix, Plan.Suffix.Len() * sizeof(TCHAR));
+	Dest += Plan.Suffix.Len();
+
+	*Dest = TEXT('\0');
+}
@@ -0,0 +1,172 @@
+#include "RenameNameReference.h"
+#include "Internationalization/Regex.h"
+
+// every match replaced, $n and ${n} insert capture groups and $$ a dollar sign
+static FString ReplaceRegex(const FString& Name, const FRenameOptions& Options)
+{
+	const FRegexPattern Pattern(Options.Find, Options.bFindIgnoreCase ? ERegexPatternFlags::CaseInsensitive : ERegexPatternFlags::None);
+	FRegexMatcher Matcher(Pattern, Name);
+
+	FString Out;
+	int32 Copied = 0;
+	while (Matcher.FindNext())
+	{
+		Out += Name.Mid(Copied, Matcher.GetMatchBeginning() - Copied);
+		for (int32 i = 0; i < Options.Replace.Len(); ++i)
+		{
+			const TCHAR C = Options.Replace[i];
+			int32 Group = INDEX_NONE;
+			int32 End = i;
+			if (C == TEXT('$') && i + 1 < Options.Replace.Len() && FChar::IsDigit(Options.Replace[i + 1]))
+			{
+				Group = Options.Replace[i + 1] - TEXT('0');
+				End = i + 1;
+			}
+			else if (C == TEXT('$') && i + 1 < Options.Replace.Len() && Options.Replace[i + 1] == TEXT('{'))
+			{
+				const int32 Close = Options.Replace.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, i + 2);
+				if (Close > i + 2 && LexTryParseString(Group, *Options.Replace.Mid(i + 2, Close - i - 2)) && Group >= 0)
+				{
+					End = Close;
+				}
+				else
+				{
+					Group = INDEX_NONE;
+				}
+			}
+
+			if (Group != INDEX_NONE)
+			{
+				const int32 GroupBegin = Matcher.GetCaptureGroupBeginning(Group);
+				const int32 GroupEnd = Matcher.GetCaptureGroupEnding(Group);
+				if (GroupBegin >= 0 && GroupEnd >= GroupBegin)
+				{
+					Out += Name.Mid(GroupBegin, GroupEnd - GroupBegin);
+				}
+				i = End;
+			}
+			else
+			{
+				Out.AppendChar(C);
+				if (C == TEXT('$') && i + 1 < Options.Replace.Len() && Options.Replace[i + 1] == TEXT('$'))
+				{
+					++i;
+				}
+			}
+		}
+		Copied = Matcher.GetMatchEnding();
+	}
+	return Out + Name.Mid(Copied);
+}
+
+FString RenameNameReference::ApplyCaseOp(const FString& In, ECaseOp Op)
+{
+	switch (Op)
+	{
+	case ECaseOp::Upper:
+		return In.ToUpper();
+	case ECaseOp::Lower:
+		return In.ToLower();
+	case ECaseOp::CapitalizeFirst:
+		if (In.Len() == 0) return In;
+		{
+			FString Out = In;
+			Out[0] = FChar::ToUpper(Out[0]);
+			return Out;
+		}
+	case ECaseOp::PascalCase:
+	case ECaseOp::SnakeCase:
+	case ECaseOp::CamelCase:
+	case ECaseOp::TitleCase:
+		{
+			TArray<FString> Words;
+			FString Word;
+			for (int32 i = 0; i < In.Len(); ++i)
+			{
+				const TCHAR C = In[i];
+				if (C == TEXT('_') || C == TEXT('-') || C == TEXT(' '))
+				{
+					if (!Word.IsEmpty()) Words.Add(MoveTemp(Word));
+					Word.Reset();
+					continue;
+				}
+				const bool bNextLower = i + 1 < In.Len() && FChar::IsLower(In[i + 1]);
+				if (!Word.IsEmpty() && FChar::IsUpper(C) && (!FChar::IsUpper(In[i - 1]) || bNextLower))
+				{
+					Words.Add(MoveTemp(Word));
+					Word.Reset();
+				}
+				Word.AppendChar(C);
+			}
+			if (!Word.IsEmpty()) Words.Add(MoveTemp(Word));
+			if (Words.Num() == 0) return In;
+
+			FString Out;
+			for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+			{
+				FString Cased = Words[WordIndex].ToLower();
+				if (Op != ECaseOp::SnakeCase && !(Op == ECaseOp::CamelCase && WordIndex == 0))
+				{
+					Cased[0] = FChar::ToUpper(Words[WordIndex][0]);
+				}
+				if (WordIndex > 0 && (Op == ECaseOp::SnakeCase || Op == ECaseOp::TitleCase))
+				{
+					Out += TEXT("_");
+				}
+				Out += Cased;
+			}
+			return Out;
+		}
+	default:
+		return In;
+	}
+}
+
+FString RenameNameReference::GenerateNewName(const FString& OldName, const FRenameOptions& Options, int32 Index)
+{
+	FString Base = OldName;
+	if (Options.bFindRegex && !Options.Find.IsEmpty())
+	{
+		Base = ReplaceRegex(Base, Options);
+	}
+
+	const TArray<FRenameReplaceRule> Table = MakeReplaceTable(Options);
+	if (Table.Num() == 1)
+	{
+		Base = Base.Replace(*Table[0].Find, *Table[0].Replace, ESearchCase::CaseSensitive);
+	}
+	else if (Table.Num() > 1)
+	{
+		// the first rule in table order that matches at a position replaces there, scanning continues after it
+		FString Replaced;
+		for (int32 Pos = 0; Pos < Base.Len();)
+		{
+			const FRenameReplaceRule* Match = Table.FindByPredicate([&Base, Pos](const FRenameReplaceRule& Rule)
+			{
+				return FCString::Strncmp(*Base + Pos, *Rule.Find, Rule.Find.Len()) == 0;
+			});
+			if (Match)
+			{
+				Replaced += Match->Replace;
+				Pos += Match->Find.Len();
+			}
+			else
+			{
+				Replaced.AppendChar(Base[Pos++]);
+			}
+		}
+		Base = MoveTemp(Replaced);
+	}
+
+	Base = ApplyCaseOp(Base, Options.CaseOp);
+
+	FString NumberPart;
+	if (Options.bUseNumbering)
+	{
+		int32 Number = Options.StartNumber + Index;
+		NumberPart = FString::Printf(TEXT("%0*d"), FMath::Max(1, Options.Padding), Number);
+		NumberPart = TEXT("_") + NumberPart;
+	}
+
+	return Options.Prefix + Base + NumberPart + Options.Suffix;
+}
@@ -0,0 +1,66 @@
+#include "RenamePreviewRows.h"
+
+void FRenamePreviewRows::Reset()
+{
+	Chars.Reset();
+	OldNames.Reset();
+	NewNames.Reset();
+	Collisions.Reset();
+	BatchDuplicates.Reset();
+	ActorRows.Reset();
+	SourceIndices.Reset();
+}
+
+void FRenamePreviewRows::Reserve(int32 NumRows, int32 NumChars)
+{
+	Chars.Reserve(NumChars);
+	OldNames.Reserve(NumRows);
+	NewNames.Reserve(NumRows);
+	Collisions.Reserve(NumRows);
+	BatchDuplicates.Reserve(NumRows);
+	ActorRows.Reserve(NumRows);
+	SourceIndices.Reserve(NumRows);
+}
+
+int32 FRenamePreviewRows::Add(FStringView OldName, FStringView NewName, bool bCollision, ERenameItemKind Kind, int32 SourceIndex)
+{
+	OldNames.Add(AddChars(OldName));
+	NewNames.Add(AddChars(NewName));
+	Collisions.Add(bCollision);
+	BatchDuplicates.Add(false);
+	ActorRows.Add(Kind == ERenameItemKind::Actor);
+	return SourceIndices.Add(SourceIndex);
+}
+
+void FRenamePreviewRows::Append(const FRenamePreviewRows& Other)
+{
+	const int32 CharOffset = Chars.Num();
+	Chars.Append(Other.Chars);
+	for (int32 Row = 0; Row < Other.Num(); ++Row)
+	{
+		OldNames.Add({ Other.OldNames[Row].Start + CharOffset, Other.OldNames[Row].Len });
+		NewNames.Add({ Other.NewNames[Row].Start + CharOffset, Other.NewNames[Row].Len });
+		Collisions.Add(Other.Collisions[Row]);
+		BatchDuplicates.Add(Other.BatchDuplicates[Row]);
+		ActorRows.Add(Other.ActorRows[Row]);
+	}
+	SourceIndices.Append(Other.SourceIndices);
+}
+
+void FRenamePreviewRows::SetNewName(int32 Row, FStringView NewName)
+{
+	NewNames[Row] = AddChars(NewName);
+}
+
+SIZE_T FRenamePreviewRows::GetAllocatedSize() const
+{
+	return Chars.GetAllocatedSize() + OldNames.GetAllocatedSize() + NewNames.GetAllocatedSize()
+		+ Collisions.GetAllocatedSize() + BatchDuplicates.GetAllocatedSize() + ActorRows.GetAllocatedSize() + SourceIndices.GetAllocatedSize();
+}
+
+FRenamePreviewRows::FSpan FRenamePreviewRows::AddChars(FStringView Text)
+{
+	const FSpan Span = { Chars.Num(), Text.Len() };
+	Chars.Append(Text.GetData(), Text.Len());
+	return Span;
+}
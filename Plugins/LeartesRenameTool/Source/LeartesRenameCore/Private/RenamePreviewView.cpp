@@ -0,0 +1,159 @@
+#include "RenamePreviewView.h"
+#include "Algo/Sort.h"
+
+// characters that fold together when names are compared
+static FORCEINLINE uint32 FoldNameChar(TCHAR C)
+{
+	if (uint32(C) < 128)
+	{
+		return uint32(C) - 'a' < 26u ? uint32(C) - 32 : uint32(C);
+	}
+	return uint32(FChar::ToUpper(C));
+}
+
+// four folded characters from First on, the first one in the highest bits, zero past the end
+static FORCEINLINE uint64 PackNameKey(FStringView Name, int32 First)
+{
+	uint64 Key = 0;
+	for (int32 i = First; i < First + 4; ++i)
+	{
+		Key = (Key << 16) | (i < Name.Len() ? FoldNameChar(Name[i]) & 0xFFFF : 0);
+	}
+	return Key;
+}
+
+static int32 CompareNamesFrom(FStringView A, FStringView B, int32 From)
+{
+	const int32 Len = FMath::Min(A.Len(), B.Len());
+	for (int32 i = From; i < Len; ++i)
+	{
+		const uint32 FoldedA = FoldNameChar(A[i]);
+		const uint32 FoldedB = FoldNameChar(B[i]);
+		if (FoldedA != FoldedB)
+		{
+			return FoldedA < FoldedB ? -1 : 1;
+		}
+	}
+	return A.Len() - B.Len();
+}
+
+int32 FRenamePreviewView::CompareNames(FStringView A, FStringView B)
+{
+	return CompareNamesFrom(A, B, 0);
+}
+
+void FRenamePreviewView::Invalidate()
+{
+	for (TArray<int32>& Order : ColumnOrders)
+	{
+		Order.Reset();
+	}
+}
+
+void FRenamePreviewView::Build(const FRenamePreviewRows& Rows, ERenamePreviewColumn Column, bool bDescending, bool bProblemsOnly, TArray<int32>& OutRows)
+{
+	OutRows.Reset(bProblemsOnly ? 0 : Rows.Num());
+
+	if (Column == ERenamePreviewColumn::None || Column == ERenamePreviewColumn::Num)
+	{
+		for (int32 i = 0; i < Rows.Num(); ++i)
+		{
+			const int32 Row = bDescending ? Rows.Num() - 1 - i : i;
+			if (PassesFilter(Rows, Row, bProblemsOnly)) OutRows.Add(Row);
+		}
+		return;
+	}
+
+	const TArray<int32>& Order = GetColumnOrder(Rows, Column);
+	for (int32 i = 0; i < Order.Num(); ++i)
+	{
+		const int32 Row = Order[bDescending ? Order.Num() - 1 - i : i];
+		if (PassesFilter(Rows, Row, bProblemsOnly)) OutRows.Add(Row);
+	}
+}
+
+const TArray<int32>& FRenamePreviewView::GetColumnOrder(const FRenamePreviewRows& Rows, ERenamePreviewColumn Column)
+{
+	// rows appended since the order was built make it stale as well
+	TArray<int32>& Order = ColumnOrders[int32(Column)];
+	if (Order.Num() == Rows.Num() && Rows.Num() > 0)
+	{
+		return Order;
+	}
+
+	switch (Column)
+	{
+	case ERenamePreviewColumn::OldName:
+		SortByName(Rows, false, Order);
+		break;
+	case ERenamePreviewColumn::NewName:
+		SortByName(Rows, true, Order);
+		break;
+	case ERenamePreviewColumn::Status:
+		SortByRank(Rows, [&Rows](int32 Row) { return (Rows.IsCollision(Row) ? 2 : 0) | (Rows.IsBatchDuplicate(Row) ? 1 : 0); }, 4, Order);
+		break;
+	case ERenamePreviewColumn::Kind:
+		SortByRank(Rows, [&Rows](int32 Row) { return int32(Rows.GetKind(Row)); }, 2, Order);
+		break;
+	default:
+		break;
+	}
+	return Order;
+}
+
+//most comparisons are settled by the packed keys and never touch the arena
+void FRenamePreviewView::SortByName(const FRenamePreviewRows& Rows, bool bNewNames, TArray<int32>& OutOrder)
+{
+	struct FKeyedRow
+	{
+		uint64 Key0;
+		uint64 Key1;
+		int32 Row;
+	};
+
+	auto GetName = [&Rows, bNewNames](int32 Row) { return bNewNames ? Rows.GetNewName(Row) : Rows.GetOldName(Row); };
+
+	TArray<FKeyedRow> Keyed;
+	Keyed.SetNumUninitialized(Rows.Num());
+	for (int32 Row = 0; Row < Rows.Num(); ++Row)
+	{
+		const FStringView Name = GetName(Row);
+		Keyed[Row] = { PackNameKey(Name, 0), PackNameKey(Name, 4), Row };
+	}
+
+	Algo::Sort(Keyed, [&GetName](const FKeyedRow& A, const FKeyedRow& B)
+	{
+		if (A.Key0 != B.Key0) return A.Key0 < B.Key0;
+		if (A.Key1 != B.Key1) return A.Key1 < B.Key1;
+
+		const int32 Compare = CompareNamesFrom(GetName(A.Row), GetName(B.Row), 8);
+		return Compare != 0 ? Compare < 0 : A.Row < B.Row;
+	});
+
+	OutOrder.SetNumUninitialized(Rows.Num());
+	for (int32 i = 0; i < Keyed.Num(); ++i)
+	{
+		OutOrder[i] = Keyed[i].Row;
+	}
+}
+
+//counting sort, stable so rows of the same rank keep arena order
+void FRenamePreviewView::SortByRank(const FRenamePreviewRows& Rows, TFunctionRef<int32(int32)> GetRank, int32 NumRanks, TArray<int32>& OutOrder)
+{
+	TArray<int32, TInlineAllocator<8>> Starts;
+	Starts.SetNumZeroed(NumRanks + 1);
+	for (int32 Row = 0; Row < Rows.Num(); ++Row)
+	{
+		++Starts[GetRank(Row) + 1];
+	}
+	for (int32 Rank = 1; Rank <= NumRanks; ++Rank)
+	{
+		Starts[Rank] += Starts[Rank - 1];
+	}
+
+	OutOrder.SetNumUninitialized(Rows.Num());
+	for (int32 Row = 0; Row < Rows.Num(); ++Row)
+	{
+		OutOrder[Starts[GetRank(Row)]++] = Row;
+	}
+}
@@ -0,0 +1,267 @@
+#include "RenameRegex.h"
+#include "Algo/AnyOf.h"
+#include "Misc/ScopeLock.h"
+#include "String/Find.h"
+
+// compiled patterns kept for reuse, typing into the widget goes through a few of them quickly
+static constexpr int32 MaxCachedRegexes = 16;
+
+TSharedRef<const FRenameRegex, ESPMode::ThreadSafe> FRenameRegex::Get(const FString& Pattern, const FString& Replace, bool bIgnoreCase)
+{
+	struct FEntry
+	{
+		FString Pattern;
+		FString Replace;
+		bool bIgnoreCase;
+		TSharedRef<const FRenameRegex, ESPMode::ThreadSafe> Regex;
+	};
+
+	static FCriticalSection CacheLock;
+	static TArray<FEntry> Cache;
+
+	FScopeLock Lock(&CacheLock);
+
+	// most recently used last
+	for (int32 i = Cache.Num() - 1; i >= 0; --i)
+	{
+		const FEntry& Entry = Cache[i];
+		if (Entry.bIgnoreCase == bIgnoreCase && Entry.Pattern.Equals(Pattern, ESearchCase::CaseSensitive) && Entry.Replace.Equals(Replace, ESearchCase::CaseSensitive))
+		{
+			FEntry Found = Cache[i];
+			Cache.RemoveAt(i);
+			return Cache.Add_GetRef(MoveTemp(Found)).Regex;
+		}
+	}
+
+	if (Cache.Num() >= MaxCachedRegexes)
+	{
+		Cache.RemoveAt(0);
+	}
+	return Cache.Add_GetRef({ Pattern, Replace, bIgnoreCase, MakeShared<FRenameRegex, ESPMode::ThreadSafe>(Pattern, Replace, bIgnoreCase) }).Regex;
+}
+
+FRenameRegex::FRenameRegex(const FString& InPattern, const FString& Replace, bool bInIgnoreCase)
+	: Pattern(InPattern, bInIgnoreCase ? ERegexPatternFlags::CaseInsensitive : ERegexPatternFlags::None)
+	, RequiredLiteral(FindRequiredLiteral(InPattern))
+	, bIgnoreCase(bInIgnoreCase)
+{
+	// case folding beyond ascii is left to the regex engine
+	if (bIgnoreCase && !FCString::IsPureAnsi(*RequiredLiteral))
+	{
+		RequiredLiteral.Reset();
+	}
+
+	FString Literal;
+	auto FlushLiteral = [this, &Literal]()
+	{
+		if (!Literal.IsEmpty())
+		{
+			Segments.Add({ MoveTemp(Literal), INDEX_NONE });
+			Literal.Reset();
+		}
+	};
+
+	for (int32 i = 0; i < Replace.Len(); ++i)
+	{
+		const TCHAR C = Replace[i];
+		const TCHAR Next = i + 1 < Replace.Len() ? Replace[i + 1] : TEXT('\0');
+		if (C == TEXT('$') && FChar::IsDigit(Next))
+		{
+			FlushLiteral();
+			Segments.Add({ FString(), Next - TEXT('0') });
+			++i;
+		}
+		else if (C == TEXT('$') && Next == TEXT('{'))
+		{
+			const int32 Close = Replace.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, i + 2);
+			int32 Group = INDEX_NONE;
+			if (Close != INDEX_NONE && Close > i + 2 && LexTryParseString(Group, *Replace.Mid(i + 2, Close - i - 2)) && Group >= 0)
+			{
+				FlushLiteral();
+				Segments.Add({ FString(), Group });
+				i = Close;
+			}
+			else
+			{
+				Literal.AppendChar(C);
+			}
+		}
+		else if (C == TEXT('$') && Next == TEXT('$'))
+		{
+			Literal.AppendChar(C);
+			++i;
+		}
+		else
+		{
+			Literal.AppendChar(C);
+		}
+	}
+	FlushLiteral();
+}
+
+bool FRenameRegex::MayMatch(FStringView Name) const
+{
+	if (RequiredLiteral.IsEmpty())
+	{
+		return true;
+	}
+	if (!bIgnoreCase)
+	{
+		return UE::String::FindFirst(Name, RequiredLiteral, ESearchCase::CaseSensitive) != INDEX_NONE;
+	}
+
+	// icu folds a few non ascii characters such as the kelvin sign onto ascii letters, such names always go to the engine
+	return UE::String::FindFirst(Name, RequiredLiteral, ESearchCase::IgnoreCase) != INDEX_NONE
+		|| Algo::AnyOf(Name, [](TCHAR C) { return uint32(C) >= 128; });
+}
+
+bool FRenameRegex::Apply(FStringView Name, FString& Out) const
+{
+	if (!MayMatch(Name))
+	{
+		return false;
+	}
+
+	const FString Input(Name);
+	FRegexMatcher Matcher(Pattern, Input);
+
+	bool bMatched = false;
+	int32 Copied = 0;
+	while (Matcher.FindNext())
+	{
+		if (!bMatched)
+		{
+			Out.Reset(Input.Len() + 16);
+			bMatched = true;
+		}
+
+		const int32 Begin = Matcher.GetMatchBeginning();
+		Out.AppendChars(*Input + Copied, Begin - Copied);
+		for (const FSegment& Segment : Segments)
+		{
+			if (Segment.Group == INDEX_NONE)
+			{
+				Out += Segment.Text;
+				continue;
+			}
+
+			// groups that did not take part in the match, or do not exist, insert nothing
+			const int32 GroupBegin = Matcher.GetCaptureGroupBeginning(Segment.Group);
+			const int32 GroupEnd = Matcher.GetCaptureGroupEnding(Segment.Group);
+			if (GroupBegin >= 0 && GroupEnd >= GroupBegin)
+			{
+				Out.AppendChars(*Input + GroupBegin, GroupEnd - GroupBegin);
+			}
+		}
+		Copied = Matcher.GetMatchEnding();
+	}
+
+	if (bMatched)
+	{
+		Out.AppendChars(*Input + Copied, Input.Len() - Copied);
+	}
+	return bMatched;
+}
+
+//conservative: only top level characters outside groups, classes and escapes count, and any
+//alternation or inline option gives up, a missed literal only costs speed while a wrong one loses matches
+FString FRenameRegex::FindRequiredLiteral(const FString& Pattern)
+{
+	if (Pattern.Contains(TEXT("(?")) || Pattern.Contains(TEXT("\\Q")))
+	{
+		return FString();
+	}
+
+	FString Best;
+	FString Run;
+	auto EndRun = [&Best, &Run]()
+	{
+		if (Run.Len() > Best.Len())
+		{
+			Best = Run;
+		}
+		Run.Reset();
+	};
+
+	int32 Depth = 0;
+	bool bInClass = false;
+	for (int32 i = 0; i < Pattern.Len(); ++i)
+	{
+		const TCHAR C = Pattern[i];
+		const TCHAR Next = i + 1 < Pattern.Len() ? Pattern[i + 1] : TEXT('\0');
+
+		if (bInClass)
+		{
+			if (C == TEXT('\\')) ++i;
+			else if (C == TEXT(']')) bInClass = false;
+			continue;
+		}
+		if (C == TEXT('\\'))
+		{
+			// an escaped symbol is a plain character, escaped letters and digits are classes, anchors or references
+			++i;
+			if (Depth == 0 && Next != TEXT('\0') && !FChar::IsAlnum(Next))
+			{
+				if (Pattern.IsValidIndex(i + 1) && FCString::Strchr(TEXT("?*{"), Pattern[i + 1]))
+				{
+					EndRun();
+				}
+				else
+				{
+					Run.AppendChar(Next);
+				}
+			}
+			else
+			{
+				EndRun();
+			}
+			continue;
+		}
+
+		switch (C)
+		{
+		case TEXT('|'):
+			if (Depth == 0) return FString();
+			break;
+		case TEXT('['):
+			bInClass = true;
+			EndRun();
+			break;
+		case TEXT('('):
+			++Depth;
+			EndRun();
+			break;
+		case TEXT(')'):
+			Depth = FMath::Max(Depth - 1, 0);
+			break;
+		case TEXT('?'):
+		case TEXT('*'):
+		case TEXT('{'):
+			// the character before is optional or repeated any number of times
+			if (Depth == 0 && Run.Len() > 0)
+			{
+				Run.LeftChopInline(1);
+			}
+			EndRun();
+			if (C == TEXT('{'))
+			{
+				while (i + 1 < Pattern.Len() && Pattern[i] != TEXT('}')) ++i;
+			}
+			break;
+		case TEXT('+'):
+		case TEXT('.'):
+		case TEXT('^'):
+		case TEXT('$'):
+			EndRun();
+			break;
+		default:
+			if (Depth == 0)
+			{
+				Run.AppendChar(C);
+			}
+			break;
+		}
+	}
+	EndRun();
+	return Best;
+}
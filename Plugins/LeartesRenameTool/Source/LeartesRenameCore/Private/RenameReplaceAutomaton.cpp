@@ -0,0 +1,152 @@
+#include "RenameReplaceAutomaton.h"
+
+FRenameReplaceAutomaton::FRenameReplaceAutomaton(TArrayView<const FRenameReplaceRule> Rules)
+{
+	FindLens.Reserve(Rules.Num());
+	for (const FRenameReplaceRule& Rule : Rules)
+	{
+		FindLens.Add(Rule.Find.Len());
+		for (TCHAR C : Rule.Find)
+		{
+			GetOrAddCharClass(C);
+		}
+	}
+
+	// build the trie with sparse children, every state gets a dense row once the classes are known
+	TArray<TMap<int32, int32>> Children;
+	Children.AddDefaulted();
+	Depths.Add(0);
+	MatchLens.Add(INDEX_NONE);
+	MatchRules.Add(INDEX_NONE);
+
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FString& Find = Rules[RuleIndex].Find;
+		if (Find.IsEmpty()) continue;
+
+		int32 State = 0;
+		for (TCHAR C : Find)
+		{
+			const int32 Class = GetCharClass(C);
+			if (const int32* Child = Children[State].Find(Class))
+			{
+				State = *Child;
+				continue;
+			}
+
+			const int32 NewState = Children.Num();
+			Children[State].Add(Class, NewState);
+			Children.AddDefaulted();
+			Depths.Add(Depths[State] + 1);
+			MatchLens.Add(INDEX_NONE);
+			MatchRules.Add(INDEX_NONE);
+			State = NewState;
+		}
+
+		// a repeated find string keeps its first rule
+		if (MatchRules[State] == INDEX_NONE)
+		{
+			MatchRules[State] = RuleIndex;
+			MatchLens[State] = Find.Len();
+		}
+	}
+
+	// breadth first, so the failure target of a state is complete before the state itself
+	const int32 NumStates = Children.Num();
+	Next.SetNumZeroed(NumStates * NumClasses);
+	TArray<int32> Fail;
+	Fail.SetNumZeroed(NumStates);
+	TArray<int32> Queue;
+	Queue.Reserve(NumStates);
+
+	for (const TPair<int32, int32>& Child : Children[0])
+	{
+		Next[Child.Key] = Child.Value;
+		Queue.Add(Child.Value);
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 State = Queue[Head];
+		const int32 FailState = Fail[State];
+
+		// a state without a match of its own reports the longest one of its failure chain
+		if (MatchRules[State] == INDEX_NONE)
+		{
+			MatchRules[State] = MatchRules[FailState];
+			MatchLens[State] = MatchLens[FailState];
+		}
+
+		for (int32 Class = 0; Class < NumClasses; ++Class)
+		{
+			Next[State * NumClasses + Class] = Next[FailState * NumClasses + Class];
+		}
+		for (const TPair<int32, int32>& Child : Children[State])
+		{
+			Fail[Child.Value] = Next[FailState * NumClasses + Child.Key];
+			Next[State * NumClasses + Child.Key] = Child.Value;
+			Queue.Add(Child.Value);
+		}
+	}
+}
+
+int32 FRenameReplaceAutomaton::GetOrAddCharClass(TCHAR C)
+{
+	int32 Class = GetCharClass(C);
+	if (Class == 0)
+	{
+		Class = NumClasses++;
+		if (uint32(C) < 128)
+		{
+			AsciiClasses[C] = Class;
+		}
+		else
+		{
+			OtherClasses.Add(C, Class);
+		}
+	}
+	return Class;
+}
+
+void FRenameReplaceAutomaton::FindMatches(FStringView Name, FMatchArray& OutMatches) const
+{
+	const TCHAR* Chars = Name.GetData();
+	const int32 Len = Name.Len();
+
+	// best match seen so far, it is kept until no longer or earlier rule can still start at or before it
+	int32 CandidatePos = INDEX_NONE;
+	int32 CandidateRule = INDEX_NONE;
+	int32 State = 0;
+
+	for (int32 i = 0; i < Len || CandidatePos != INDEX_NONE;)
+	{
+		if (i < Len)
+		{
+			State = Next[State * NumClasses + GetCharClass(Chars[i])];
+			++i;
+
+			// the longest match ending here starts first, shorter ones cannot beat it
+			const int32 Rule = MatchRules[State];
+			if (Rule != INDEX_NONE)
+			{
+				const int32 Start = i - MatchLens[State];
+				if (CandidatePos == INDEX_NONE || Start < CandidatePos || (Start == CandidatePos && Rule < CandidateRule))
+				{
+					CandidatePos = Start;
+					CandidateRule = Rule;
+				}
+			}
+		}
+
+		// final at the end of the name, or once the partial match in progress starts after it
+		if (CandidatePos != INDEX_NONE && (i == Len || i - Depths[State] > CandidatePos))
+		{
+			OutMatches.Add({ CandidatePos, CandidateRule });
+
+			// scanning resumes right after the replaced text, characters read past it are read again
+			i = CandidatePos + FindLens[CandidateRule];
+			State = 0;
+			CandidatePos = INDEX_NONE;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "RenameTypes.h"
+
+const TCHAR* LexToString(ECaseOp Op)
+{
+	switch (Op)
+	{
+	case ECaseOp::Upper: return TEXT("Upper");
+	case ECaseOp::Lower: return TEXT("Lower");
+	case ECaseOp::CapitalizeFirst: return TEXT("CapitalizeFirst");
+	case ECaseOp::PascalCase: return TEXT("PascalCase");
+	case ECaseOp::SnakeCase: return TEXT("snake_case");
+	case ECaseOp::CamelCase: return TEXT("camelCase");
+	case ECaseOp::TitleCase: return TEXT("Title_Case");
+	default: return TEXT("None");
+	}
+}
+
+bool LexTryParseString(ECaseOp& OutOp, const TCHAR* Buffer)
+{
+	const ECaseOp Ops[] = { ECaseOp::None, ECaseOp::Upper, ECaseOp::Lower, ECaseOp::CapitalizeFirst,
+		ECaseOp::PascalCase, ECaseOp::SnakeCase, ECaseOp::CamelCase, ECaseOp::TitleCase };
+	for (ECaseOp Op : Ops)
+	{
+		if (FCString::Stricmp(Buffer, LexToString(Op)) == 0)
+		{
+			OutOp = Op;
+			return true;
+		}
+	}
+	return false;
+}
+
+TArray<FRenameReplaceRule> MakeReplaceTable(const FRenameOptions& Options)
+{
+	TArray<FRenameReplaceRule> Table;
+	Table.Reserve(Options.ReplaceRules.Num() + 1);
+	if (!Options.Find.IsEmpty() && !Options.bFindRegex)
+	{
+		Table.Add({ Options.Find, Options.Replace });
+	}
+	for (const FRenameReplaceRule& Rule : Options.ReplaceRules)
+	{
+		if (!Rule.Find.IsEmpty())
+		{
+			Table.Add(Rule);
+		}
+	}
+	return Table;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenameTypes.h"
+
+//case conversion kernels of the name plan
+//upper and lower case convert in place, ascii runs a block of characters at a time and anything
+//else falls back to FChar, so the output equals FString::ToUpper/ToLower
+//the word styles split a name into words in one pass: '_', '-' and spaces separate words, and a word
+//also starts at an upper case letter following a lower case one or a digit, or ending an acronym
+//("HTTPServer" is "HTTP" and "Server"), letters inside a word are lower cased
+
+namespace RenameCase
+{
+	LEARTESRENAMECORE_API void ToUpperInPlace(TCHAR* Chars, int32 Len);
+	LEARTESRENAMECORE_API void ToLowerInPlace(TCHAR* Chars, int32 Len);
+
+	// PascalCase, snake_case, camelCase and Title_Case
+	inline bool IsWordStyle(ECaseOp Op)
+	{
+		return Op == ECaseOp::PascalCase || Op == ECaseOp::SnakeCase || Op == ECaseOp::CamelCase || Op == ECaseOp::TitleCase;
+	}
+
+	// Dest needs room for MaxWordStyleLen(Name.Len()) characters, returns the number written
+	// a name without any word is copied unchanged, an empty name is never produced
+	LEARTESRENAMECORE_API int32 ApplyWordStyle(ECaseOp Op, FStringView Name, TCHAR* Dest);
+
+	// a separator is written before every word but the first at most
+	inline int32 MaxWordStyleLen(int32 NameLen)
+	{
+		return NameLen * 2;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+//character level difference between an old and a new name, for highlighting the preview
+//the common prefix and suffix are split off first and only the middle is aligned on a longest common
+//subsequence, single matching characters between two changes join the change so highlights stay readable
+
+enum class ERenameDiffOp : uint8
+{
+	Equal,
+	Insert,
+	Remove,
+	Replace
+};
+
+// a run of one operation, an insert has no old characters and a remove no new ones
+struct FRenameDiffSpan
+{
+	ERenameDiffOp Op = ERenameDiffOp::Equal;
+	int32 OldStart = 0;
+	int32 OldLen = 0;
+	int32 NewStart = 0;
+	int32 NewLen = 0;
+};
+
+using FRenameNameDiff = TArray<FRenameDiffSpan, TInlineAllocator<8>>;
+
+namespace RenameNameDiff
+{
+	// spans covering both names from start to end, in order
+	// middles too long to align are reported as a single replace
+	LEARTESRENAMECORE_API void Compute(FStringView OldName, FStringView NewName, FRenameNameDiff& OutSpans);
+}
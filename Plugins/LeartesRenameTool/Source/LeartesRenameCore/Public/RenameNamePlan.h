@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenameRegex.h"
+#include "RenameReplaceAutomaton.h"
+#include "RenameTypes.h"
+
+//rename options compiled once per preview or apply into a name generation plan
+//the plan is specialized on the active steps (find, case, numbering) and knows the exact
+//length of every output name, so each name is written into a single pre-sized buffer
+//(word case styles change the length and are applied in a scratch buffer first)
+//a replace table of several rules is compiled into an automaton, so one scan serves every rule
+
+class LEARTESRENAMECORE_API FRenameNamePlan
+{
+public:
+
+	explicit FRenameNamePlan(const FRenameOptions& Options);
+
+	// the find/replace and case steps alone, their output only depends on the old name
+	static FRenameNamePlan BaseStage(const FRenameOptions& Options);
+
+	// prefix, numbering and suffix around a name the base stage already produced
+	// ComposeStage(Options).Generate(BaseStage(Options).Generate(Old), Index) equals the full plan output
+	static FRenameNamePlan ComposeStage(const FRenameOptions& Options);
+
+	// write the new name for OldName at batch position Index into Out, reusing its allocation
+	void Generate(FStringView OldName, int32 Index, FString& Out) const
+	{
+		GenerateFn(*this, OldName, Index, Out);
+	}
+
+	FString Generate(FStringView OldName, int32 Index) const
+	{
+		FString Out;
+		GenerateFn(*this, OldName, Index, Out);
+		return Out;
+	}
+
+private:
+
+	using FGenerateFn = void (*)(const FRenameNamePlan&, FStringView, int32, FString&);
+
+	template<bool bFind, bool bCase, bool bNumber>
+	static void GenerateImpl(const FRenameNamePlan& Plan, FStringView OldName, int32 Index, FString& Out);
+
+	// writes the "_<padded number>" part, returns the number of characters written
+	int32 FormatNumber(int32 Index, TCHAR* Dest) const;
+
+	// copies Src into Dest with the find matches replaced, returns the end of the written text
+	TCHAR* WriteReplaced(const TCHAR* Src, int32 SrcLen, TArrayView<const FRenameReplaceAutomaton::FMatch> Matches, TCHAR* Dest) const;
+
+private:
+
+	FString Prefix;
+	FString Suffix;
+	// Find/Replace and the replace rules, the automaton is only built for more than one rule
+	TArray<FRenameReplaceRule> ReplaceTable;
+	TSharedPtr<const FRenameReplaceAutomaton, ESPMode::ThreadSafe> Automaton;
+	// Find/Replace in regex mode, taken from the shared cache of compiled patterns
+	TSharedPtr<const FRenameRegex, ESPMode::ThreadSafe> Regex;
+
+	ECaseOp CaseOp = ECaseOp::None;
+
+	int32 StartNumber = 1;
+	int32 Padding = 1;
+
+	FGenerateFn GenerateFn = nullptr;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenameTypes.h"
+
+//the original per name concatenation path of the rename tool
+//kept as the reference output for FRenameNamePlan and as the baseline of the name benchmarks
+
+namespace RenameNameReference
+{
+	LEARTESRENAMECORE_API FString ApplyCaseOp(const FString& In, ECaseOp Op);
+
+	LEARTESRENAMECORE_API FString GenerateNewName(const FString& OldName, const FRenameOptions& Options, int32 Index);
+}
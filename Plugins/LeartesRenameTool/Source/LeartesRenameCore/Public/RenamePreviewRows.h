@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ERenameItemKind : uint8
+{
+	Asset,
+	Actor
+};
+
+//preview rows stored as columns, every name lives in one character arena
+//a row costs two spans, three flag bits and a source index instead of a shared item with two strings,
+//and resetting keeps the allocations for the next preview
+
+class LEARTESRENAMECORE_API FRenamePreviewRows
+{
+public:
+
+	int32 Num() const { return SourceIndices.Num(); }
+
+	// drop every row, the allocations are kept
+	void Reset();
+
+	void Reserve(int32 NumRows, int32 NumChars);
+
+	// returns the new row
+	int32 Add(FStringView OldName, FStringView NewName, bool bCollision, ERenameItemKind Kind, int32 SourceIndex);
+
+	// add the rows of Other after the ones already here
+	void Append(const FRenamePreviewRows& Other);
+
+	FStringView GetOldName(int32 Row) const { return GetChars(OldNames[Row]); }
+	FStringView GetNewName(int32 Row) const { return GetChars(NewNames[Row]); }
+	bool IsCollision(int32 Row) const { return Collisions[Row]; }
+	// another item of the same batch maps to the same new name
+	bool IsBatchDuplicate(int32 Row) const { return BatchDuplicates[Row]; }
+	ERenameItemKind GetKind(int32 Row) const { return ActorRows[Row] ? ERenameItemKind::Actor : ERenameItemKind::Asset; }
+	// the item the row was built from, in the order the preview went through its items
+	int32 GetSourceIndex(int32 Row) const { return SourceIndices[Row]; }
+
+	// the replaced name stays in the arena until the next reset
+	void SetNewName(int32 Row, FStringView NewName);
+	void SetCollision(int32 Row, bool bCollision) { Collisions[Row] = bCollision; }
+	void SetBatchDuplicate(int32 Row, bool bDuplicate) { BatchDuplicates[Row] = bDuplicate; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	struct FSpan
+	{
+		int32 Start = 0;
+		int32 Len = 0;
+	};
+
+	FStringView GetChars(FSpan Span) const { return FStringView(Chars.GetData() + Span.Start, Span.Len); }
+
+	FSpan AddChars(FStringView Text);
+
+private:
+
+	TArray<TCHAR> Chars;
+	TArray<FSpan> OldNames;
+	TArray<FSpan> NewNames;
+	TBitArray<> Collisions;
+	TBitArray<> BatchDuplicates;
+	TBitArray<> ActorRows;
+	TArray<int32> SourceIndices;
+};
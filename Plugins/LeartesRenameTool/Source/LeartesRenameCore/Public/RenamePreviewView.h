@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenamePreviewRows.h"
+
+//display order of the preview rows for the sorted and filtered preview list
+//the ascending order of each column is computed once and kept until the rows change, so flipping the
+//direction, switching back to a column or toggling the filter is a single pass over the rows
+//names sort ignoring case on a key of their first eight characters, the full names only break ties
+
+enum class ERenamePreviewColumn : uint8
+{
+	// arena order, the order the preview produced the rows in
+	None,
+	OldName,
+	NewName,
+	// rows without a problem first, then duplicates, then collisions
+	Status,
+	// assets before actors
+	Kind,
+
+	Num
+};
+
+class LEARTESRENAMECORE_API FRenamePreviewView
+{
+public:
+
+	// drop the column orders, needed whenever rows were replaced or patched
+	void Invalidate();
+
+	// the rows to show in display order, ties keep arena order when ascending
+	// bProblemsOnly keeps the rows that collide or duplicate another name of the batch
+	void Build(const FRenamePreviewRows& Rows, ERenamePreviewColumn Column, bool bDescending, bool bProblemsOnly, TArray<int32>& OutRows);
+
+	static bool PassesFilter(const FRenamePreviewRows& Rows, int32 Row, bool bProblemsOnly)
+	{
+		return !bProblemsOnly || Rows.IsCollision(Row) || Rows.IsBatchDuplicate(Row);
+	}
+
+	// the ordering Build uses for names, case insensitive with shorter names before longer ones they start
+	static int32 CompareNames(FStringView A, FStringView B);
+
+private:
+
+	const TArray<int32>& GetColumnOrder(const FRenamePreviewRows& Rows, ERenamePreviewColumn Column);
+
+	static void SortByName(const FRenamePreviewRows& Rows, bool bNewNames, TArray<int32>& OutOrder);
+	static void SortByRank(const FRenamePreviewRows& Rows, TFunctionRef<int32(int32)> GetRank, int32 NumRanks, TArray<int32>& OutOrder);
+
+private:
+
+	// ascending order of every column computed so far, empty until first needed
+	TArray<int32> ColumnOrders[int32(ERenamePreviewColumn::Num)];
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+
+//regex find/replace of the rename tool, compiled once per pattern and shared through a small cache
+//the replacement may refer to capture groups as $0..$9 or ${n}, $$ writes a dollar sign
+//a literal the pattern cannot match without is extracted up front, names without it skip the regex engine
+//a pattern that does not compile matches nothing
+
+class LEARTESRENAMECORE_API FRenameRegex
+{
+public:
+
+	// compiled regex for the pattern, replacement and flag, shared with every other caller asking for the same
+	static TSharedRef<const FRenameRegex, ESPMode::ThreadSafe> Get(const FString& Pattern, const FString& Replace, bool bIgnoreCase);
+
+	FRenameRegex(const FString& Pattern, const FString& Replace, bool bIgnoreCase);
+
+	// replace every match in Name, returns false and leaves Out untouched if nothing matched
+	bool Apply(FStringView Name, FString& Out) const;
+
+	// false if Name cannot contain a match
+	bool MayMatch(FStringView Name) const;
+
+private:
+
+	// longest run of plain characters every match has to contain, empty if none could be proven
+	static FString FindRequiredLiteral(const FString& Pattern);
+
+private:
+
+	// part of the replacement, either literal text or a capture group
+	struct FSegment
+	{
+		FString Text;
+		int32 Group = INDEX_NONE;
+	};
+
+	FRegexPattern Pattern;
+	TArray<FSegment> Segments;
+	FString RequiredLiteral;
+	bool bIgnoreCase = false;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenameTypes.h"
+
+//ordered find/replace table compiled into an aho-corasick automaton
+//a single left to right scan finds the matches of every rule, with the result of trying the rules in table
+//order at each position: the leftmost match wins, and the earlier rule among matches at the same position
+//matches never overlap and replaced text is not scanned again, so a one rule table acts like FString::Replace
+
+class LEARTESRENAMECORE_API FRenameReplaceAutomaton
+{
+public:
+
+	struct FMatch
+	{
+		int32 Pos = 0;
+		int32 Rule = 0;
+	};
+
+	using FMatchArray = TArray<FMatch, TInlineAllocator<16>>;
+
+	// rules with an empty find never match
+	explicit FRenameReplaceAutomaton(TArrayView<const FRenameReplaceRule> Rules);
+
+	// append the matches in Name in order of position, case sensitive
+	void FindMatches(FStringView Name, FMatchArray& OutMatches) const;
+
+private:
+
+	int32 GetCharClass(TCHAR C) const
+	{
+		if (uint32(C) < 128)
+		{
+			return AsciiClasses[C];
+		}
+		const int32* Class = OtherClasses.Find(C);
+		return Class ? *Class : 0;
+	}
+
+	int32 GetOrAddCharClass(TCHAR C);
+
+private:
+
+	// characters are mapped to dense classes, class 0 stands for every character no find string contains
+	int32 AsciiClasses[128] = {};
+	TMap<TCHAR, int32> OtherClasses;
+	int32 NumClasses = 1;
+
+	// transitions with the failure links already followed, NumStates x NumClasses, state 0 is the root
+	TArray<int32> Next;
+	// length of the trie path to each state
+	TArray<int32> Depths;
+	// longest find string ending in each state and its rule, INDEX_NONE if none does
+	TArray<int32> MatchLens;
+	TArray<int32> MatchRules;
+
+	TArray<int32> FindLens;
+};
@@ -0,0 +1,121 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// enum for case transformation options
+enum class ECaseOp : uint8
+{
+	None,
+	Upper,
+	Lower,
+	CapitalizeFirst,
+	// word styles, see RenameCase.h for how names are split into words
+	PascalCase,
+	SnakeCase,
+	CamelCase,
+	TitleCase
+};
+
+// names used for case options in rules files and logs, parsing ignores case
+LEARTESRENAMECORE_API const TCHAR* LexToString(ECaseOp Op);
+LEARTESRENAMECORE_API bool LexTryParseString(ECaseOp& OutOp, const TCHAR* Buffer);
+
+// one find/replace pair of an ordered replace table
+struct FRenameReplaceRule
+{
+	FString Find;
+	FString Replace;
+
+	bool operator==(const FRenameReplaceRule& Other) const
+	{
+		return Find.Equals(Other.Find, ESearchCase::CaseSensitive) && Replace.Equals(Other.Replace, ESearchCase::CaseSensitive);
+	}
+};
+
+// container for all rename options
+struct FRenameOptions
+{
+	FString Prefix;
+	FString Suffix;
+	FString Find;
+	FString Replace;
+	// further pairs applied in the same pass as Find/Replace, earlier pairs win where several match
+	TArray<FRenameReplaceRule> ReplaceRules;
+	// Find is a regular expression and Replace may insert its capture groups, the replace rules stay literal
+	bool bFindRegex = false;
+	// the regular expression ignores case
+	bool bFindIgnoreCase = false;
+
+	bool bUseNumbering = true;
+	int32 StartNumber = 1;
+	int32 Padding = 2;
+
+	ECaseOp CaseOp = ECaseOp::None;
+
+	bool bApplyToAssets = true;
+	bool bApplyToActors = true;
+	bool bDryRun = true;
+
+	// submit all asset renames to AssetTools together instead of one call per asset
+	bool bBulkAssetRename = true;
+	// max assets per AssetTools call in bulk mode, 0 submits the whole batch at once
+	int32 BulkRenameChunkSize = 0;
+	// rescan renamed packages over the next editor ticks instead of blocking the apply
+	bool bDeferRegistryUpdate = false;
+	// after the renames, save the renamed packages, point every referencer of the redirectors left behind at the
+	// new names, save it, and delete the redirectors
+	bool bFixupRedirectors = false;
+	// save the packages the batch dirtied once it is done, without the editor's save dialog
+	bool bSaveOnApply = false;
+
+	// give later items that map to the same name as an earlier one the smallest free _N suffix
+	bool bResolveDuplicates = false;
+
+	// split name generation and collision lookups of large batches across worker threads
+	bool bParallelPreview = true;
+
+	// record the apply in the undo buffer, unattended runs turn this off to save the memory and time
+	bool bTransactional = true;
+};
+
+// Find/Replace unless it is a regex, followed by ReplaceRules, without the pairs that have nothing to find
+LEARTESRENAMECORE_API TArray<FRenameReplaceRule> MakeReplaceTable(const FRenameOptions& Options);
+
+// preview item shown in the widget
+struct FRenamePreviewItem
+{
+	FString OldName;
+	FString NewName;
+	bool bCollision = false;
+	// another item of the same batch maps to the same new name
+	bool bBatchDuplicate = false;
+
+	FRenamePreviewItem() {}
+	FRenamePreviewItem(FString InOld, FString InNew, bool InCollision = false)
+		: OldName(MoveTemp(InOld)), NewName(MoveTemp(InNew)), bCollision(InCollision) {}
+};
+
+// outcome of a single item in a rename batch
+struct FRenameItemResult
+{
+	FString OldName;
+	FString NewName;
+	bool bSuccess = false;
+};
+
+// per item outcomes and totals of a rename batch
+struct FRenameBatchResult
+{
+	TArray<FRenameItemResult> Items;
+	int32 SuccessCount = 0;
+	int32 FailureCount = 0;
+
+	// redirector fixup stage, if it ran
+	int32 FixedUpPackages = 0;
+	int32 DeletedRedirectors = 0;
+	double FixupSeconds = 0.0;
+
+	// save on apply stage, if it ran
+	int32 SavedPackages = 0;
+	TArray<FString> SaveFailures;
+};
\ No newline at end of file
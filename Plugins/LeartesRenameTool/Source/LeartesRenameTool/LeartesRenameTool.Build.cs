@@ -29,7 +29,8 @@ public class LeartesRenameTool : ModuleRules
 				"Core",
 				"CoreUObject",
 				"Engine",
-				"InputCore"
+				"InputCore",
+				"LeartesRenameCore"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -47,7 +48,8 @@ public class LeartesRenameTool : ModuleRules
 				"AssetRegistry", 
 				"ToolMenus",
 				"LevelEditor",
-				"Projects"
+				"Projects",
+				"Json"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -0,0 +1,233 @@
+#include "ActorLabelIndex.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeRWLock.h"
+
+TUniquePtr<FActorLabelIndex> FActorLabelIndex::Instance;
+
+//create the shared index, worlds are only indexed once they are queried
+void FActorLabelIndex::Initialize()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FActorLabelIndex>();
+	}
+}
+
+//unbind editor events and release the index
+void FActorLabelIndex::Shutdown()
+{
+	if (Instance.IsValid())
+	{
+		Instance->UnregisterDelegates();
+		Instance.Reset();
+	}
+}
+
+FActorLabelIndex& FActorLabelIndex::Get()
+{
+	check(Instance.IsValid());
+	return *Instance;
+}
+
+bool FActorLabelIndex::IsLabelUsed(UWorld* World, const FString& Label, const AActor* IgnoreActor)
+{
+	if (!World) return false;
+
+	if (IsInGameThread())
+	{
+		EnsureWorld(World);
+	}
+	return IsLabelUsed(TObjectKey<UWorld>(World), Label, TObjectKey<AActor>(IgnoreActor));
+}
+
+bool FActorLabelIndex::IsLabelUsed(TObjectKey<UWorld> World, const FString& Label, TObjectKey<AActor> IgnoreActor) const
+{
+	FReadScopeLock ReadLock(IndexLock);
+
+	// the world may have been dropped while a background preview was running
+	const FWorldLabels* Labels = Worlds.Find(World);
+	if (!Labels) return false;
+
+	int32 Count = Labels->LabelCounts.FindRef(Label);
+	if (Count > 0)
+	{
+		// the ignored actor does not collide with its own label
+		const FString* IgnoredLabel = Labels->ActorLabels.Find(IgnoreActor);
+		if (IgnoredLabel && IgnoredLabel->Equals(Label, ESearchCase::CaseSensitive))
+		{
+			Count--;
+		}
+	}
+	return Count > 0;
+}
+
+//index every actor of every loaded level in the world, sublevels included
+//game thread only, which is also the only writer, so the membership check needs no lock
+void FActorLabelIndex::EnsureWorld(UWorld* World)
+{
+	check(IsInGameThread());
+	if (!World || Worlds.Contains(World)) return;
+
+	// engine events are only available once the editor is up, so bind on first use
+	RegisterDelegates();
+
+	FWorldLabels Labels;
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddActor(Labels, *It);
+	}
+
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	Worlds.Add(World, MoveTemp(Labels));
+}
+
+void FActorLabelIndex::Invalidate()
+{
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	Worlds.Empty();
+}
+
+void FActorLabelIndex::RegisterDelegates()
+{
+	if (bDelegatesRegistered || !GEngine) return;
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FActorLabelIndex::OnActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FActorLabelIndex::OnActorDeleted);
+	LabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FActorLabelIndex::OnActorLabelChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FActorLabelIndex::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FActorLabelIndex::OnLevelRemoved);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FActorLabelIndex::OnWorldCleanup);
+
+	// undo and redo can bring actors back without add events, rebuild lazily afterwards
+	UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FActorLabelIndex::Invalidate);
+
+	bDelegatesRegistered = true;
+}
+
+void FActorLabelIndex::UnregisterDelegates()
+{
+	if (!bDelegatesRegistered) return;
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(LabelChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+
+	bDelegatesRegistered = false;
+}
+
+FActorLabelIndex::FWorldLabels* FActorLabelIndex::FindWorldLabels(const AActor* Actor)
+{
+	UWorld* World = Actor ? Actor->GetWorld() : nullptr;
+	return World ? Worlds.Find(World) : nullptr;
+}
+
+void FActorLabelIndex::AddActor(FWorldLabels& Labels, AActor* Actor)
+{
+	if (!Actor || Labels.ActorLabels.Contains(Actor)) return;
+
+	const FString& Label = Actor->GetActorLabel();
+	Labels.LabelCounts.FindOrAdd(Label)++;
+	Labels.ActorLabels.Add(Actor, Label);
+}
+
+void FActorLabelIndex::RemoveActor(FWorldLabels& Labels, const AActor* Actor)
+{
+	FString OldLabel;
+	if (!Labels.ActorLabels.RemoveAndCopyValue(Actor, OldLabel)) return;
+
+	int32* Count = Labels.LabelCounts.Find(OldLabel);
+	if (Count && --(*Count) <= 0)
+	{
+		Labels.LabelCounts.Remove(OldLabel);
+	}
+}
+
+void FActorLabelIndex::OnActorAdded(AActor* Actor)
+{
+	if (FWorldLabels* Labels = FindWorldLabels(Actor))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		AddActor(*Labels, Actor);
+	}
+}
+
+void FActorLabelIndex::OnActorDeleted(AActor* Actor)
+{
+	if (FWorldLabels* Labels = FindWorldLabels(Actor))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		RemoveActor(*Labels, Actor);
+	}
+}
+
+void FActorLabelIndex::OnActorLabelChanged(AActor* Actor)
+{
+	if (FWorldLabels* Labels = FindWorldLabels(Actor))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		RemoveActor(*Labels, Actor);
+		AddActor(*Labels, Actor);
+	}
+}
+
+void FActorLabelIndex::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	FWorldLabels* Labels = World ? Worlds.Find(World) : nullptr;
+	if (!Labels || !Level) return;
+
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	for (AActor* Actor : Level->Actors)
+	{
+		AddActor(*Labels, Actor);
+	}
+}
+
+void FActorLabelIndex::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	if (!World) return;
+
+	// a null level means every level was removed from the world
+	if (!Level)
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		Worlds.Remove(World);
+		return;
+	}
+
+	if (FWorldLabels* Labels = Worlds.Find(World))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		for (AActor* Actor : Level->Actors)
+		{
+			RemoveActor(*Labels, Actor);
+		}
+	}
+}
+
+void FActorLabelIndex::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	Worlds.Remove(World);
+}
@@ -0,0 +1,162 @@
+#include "AssetNameIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopeRWLock.h"
+#include "Modules/ModuleManager.h"
+
+TUniquePtr<FAssetNameIndex> FAssetNameIndex::Instance;
+
+//create the shared index, paths are only snapshotted once they are queried
+void FAssetNameIndex::Initialize()
+{
+	if (!Instance.IsValid())
+	{
+		Instance = MakeUnique<FAssetNameIndex>();
+	}
+}
+
+//unbind registry events and release the index
+void FAssetNameIndex::Shutdown()
+{
+	if (Instance.IsValid())
+	{
+		Instance->UnregisterDelegates();
+		Instance.Reset();
+	}
+}
+
+FAssetNameIndex& FAssetNameIndex::Get()
+{
+	check(Instance.IsValid());
+	return *Instance;
+}
+
+bool FAssetNameIndex::DoesPackageExist(FName PackagePath, const FString& PackageShortName)
+{
+	if (IsInGameThread())
+	{
+		EnsurePath(PackagePath);
+	}
+
+	// a name missing from the name table cannot belong to any package, so no FName is created here
+	const FName ShortName(*PackageShortName, FNAME_Find);
+	if (ShortName.IsNone())
+	{
+		return false;
+	}
+
+	FReadScopeLock ReadLock(IndexLock);
+	const FPackageCounts* Counts = Paths.Find(PackagePath);
+	return Counts && Counts->Contains(ShortName);
+}
+
+//snapshot the packages directly under a path, subfolders are separate paths
+//game thread only, which is also the only writer, so the membership check needs no lock
+void FAssetNameIndex::EnsurePath(FName PackagePath)
+{
+	check(IsInGameThread());
+	if (Paths.Contains(PackagePath)) return;
+
+	RegisterDelegates();
+
+	FPackageCounts Counts;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(PackagePath);
+	AssetRegistry.EnumerateAssets(Filter, [&Counts](const FAssetData& AssetData)
+	{
+		Counts.FindOrAdd(FPackageName::GetShortFName(AssetData.PackageName))++;
+		return true;
+	});
+
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	Paths.Add(PackagePath, MoveTemp(Counts));
+}
+
+void FAssetNameIndex::Invalidate()
+{
+	FWriteScopeLock WriteLock(IndexLock);
+	++Version;
+	Paths.Empty();
+}
+
+void FAssetNameIndex::RegisterDelegates()
+{
+	if (bDelegatesRegistered) return;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FAssetNameIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FAssetNameIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FAssetNameIndex::OnAssetRenamed);
+
+	bDelegatesRegistered = true;
+}
+
+void FAssetNameIndex::UnregisterDelegates()
+{
+	if (!bDelegatesRegistered) return;
+
+	// the registry may already be gone during editor shutdown
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	bDelegatesRegistered = false;
+}
+
+void FAssetNameIndex::AddPackage(FName PackageName)
+{
+	// skip the path work while nothing is indexed, e.g. during the initial registry scan
+	if (Paths.Num() == 0) return;
+
+	const FName PackagePath(*FPackageName::GetLongPackagePath(PackageName.ToString()));
+	if (FPackageCounts* Counts = Paths.Find(PackagePath))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		Counts->FindOrAdd(FPackageName::GetShortFName(PackageName))++;
+	}
+}
+
+void FAssetNameIndex::RemovePackage(FName PackageName)
+{
+	if (Paths.Num() == 0) return;
+
+	const FName PackagePath(*FPackageName::GetLongPackagePath(PackageName.ToString()));
+	if (FPackageCounts* Counts = Paths.Find(PackagePath))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		++Version;
+		const FName ShortName = FPackageName::GetShortFName(PackageName);
+		int32* Count = Counts->Find(ShortName);
+		if (Count && --(*Count) <= 0)
+		{
+			Counts->Remove(ShortName);
+		}
+	}
+}
+
+void FAssetNameIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	AddPackage(AssetData.PackageName);
+}
+
+void FAssetNameIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemovePackage(AssetData.PackageName);
+}
+
+void FAssetNameIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemovePackage(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+	AddPackage(AssetData.PackageName);
+}
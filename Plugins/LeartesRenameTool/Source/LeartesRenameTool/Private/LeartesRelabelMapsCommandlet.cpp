@@ -0,0 +1,600 @@
+#include "LeartesRelabelMapsCommandlet.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "RenameLogic.h"
+#include "RenameRules.h"
+#include "RenameTypes.h"
+
+namespace RelabelMaps
+{
+	// worker exit code for stopping at the memory cap with maps left in its shard
+	static constexpr int32 ExitRestart = 3;
+
+	struct FMapReport
+	{
+		FString Map;
+		// relabeled, skipped or failed
+		FString Status;
+		FString Error;
+		int32 Actors = 0;
+		int32 Renamed = 0;
+		int32 Failed = 0;
+		double Seconds = 0.0;
+	};
+
+	static TSharedRef<FJsonObject> ToJson(const FMapReport& Report)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("map"), Report.Map);
+		Json->SetStringField(TEXT("status"), Report.Status);
+		Json->SetStringField(TEXT("error"), Report.Error);
+		Json->SetNumberField(TEXT("actors"), Report.Actors);
+		Json->SetNumberField(TEXT("renamed"), Report.Renamed);
+		Json->SetNumberField(TEXT("failed"), Report.Failed);
+		Json->SetNumberField(TEXT("seconds"), Report.Seconds);
+		return Json;
+	}
+
+	static FMapReport FromJson(const FJsonObject& Json)
+	{
+		FMapReport Report;
+		Json.TryGetStringField(TEXT("map"), Report.Map);
+		Json.TryGetStringField(TEXT("status"), Report.Status);
+		Json.TryGetStringField(TEXT("error"), Report.Error);
+		Json.TryGetNumberField(TEXT("actors"), Report.Actors);
+		Json.TryGetNumberField(TEXT("renamed"), Report.Renamed);
+		Json.TryGetNumberField(TEXT("failed"), Report.Failed);
+		Json.TryGetNumberField(TEXT("seconds"), Report.Seconds);
+		return Report;
+	}
+
+	static bool WriteReports(const FString& Path, const TArray<FMapReport>& Reports, TSharedPtr<FJsonObject> Totals = nullptr)
+	{
+		TArray<TSharedPtr<FJsonValue>> Maps;
+		for (const FMapReport& Report : Reports)
+		{
+			Maps.Add(MakeShared<FJsonValueObject>(ToJson(Report)));
+		}
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		if (Totals.IsValid())
+		{
+			Root->SetObjectField(TEXT("totals"), Totals);
+		}
+		Root->SetArrayField(TEXT("maps"), Maps);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root, Writer);
+		return FFileHelper::SaveStringToFile(Json, *Path);
+	}
+
+	// a worker that died leaves no file or the reports up to its last finished map
+	static TArray<FMapReport> ReadReports(const FString& Path)
+	{
+		TArray<FMapReport> Reports;
+		FString Text;
+		TSharedPtr<FJsonObject> Root;
+		const TArray<TSharedPtr<FJsonValue>>* Maps = nullptr;
+		if (FFileHelper::LoadFileToString(Text, *Path)
+			&& FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) && Root.IsValid()
+			&& Root->TryGetArrayField(TEXT("maps"), Maps))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Maps)
+			{
+				const TSharedPtr<FJsonObject>* Object = nullptr;
+				if (Value->TryGetObject(Object))
+				{
+					Reports.Add(FromJson(**Object));
+				}
+			}
+		}
+		return Reports;
+	}
+
+	// package names, one per line, .umap files are converted and repeated maps dropped
+	static bool LoadMapList(const FString& Path, TArray<FString>& OutMaps)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not read map list %s"), *Path);
+			return false;
+		}
+
+		for (const FString& RawLine : Lines)
+		{
+			FString Line = RawLine.TrimStartAndEnd();
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("#"))) continue;
+
+			FString MapName = Line;
+			if (Line.EndsWith(FPackageName::GetMapPackageExtension()) && !FPackageName::TryConvertFilenameToLongPackageName(Line, MapName))
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s is not inside a mounted content directory"), *Line);
+				return false;
+			}
+			if (!FPackageName::IsValidLongPackageName(MapName))
+			{
+				UE_LOG(LogTemp, Error, TEXT("'%s' is not a map package"), *Line);
+				return false;
+			}
+			OutMaps.AddUnique(MapName);
+		}
+		return true;
+	}
+
+	static bool WriteMapList(const FString& Path, const TArray<FString>& Maps)
+	{
+		return FFileHelper::SaveStringArrayToFile(Maps, *Path);
+	}
+
+	// largest maps first onto the least loaded shard, load time follows file size closely enough
+	static TArray<TArray<FString>> MakeShards(const TArray<FString>& Maps, int32 NumShards)
+	{
+		TArray<TPair<int64, FString>> Sized;
+		for (const FString& Map : Maps)
+		{
+			FString Filename;
+			const int64 Size = FPackageName::DoesPackageExist(Map, &Filename) ? IFileManager::Get().FileSize(*Filename) : 0;
+			Sized.Emplace(Size, Map);
+		}
+		Sized.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B) { return A.Key > B.Key; });
+
+		TArray<TArray<FString>> Shards;
+		TArray<int64> Loads;
+		Shards.SetNum(NumShards);
+		Loads.SetNumZeroed(NumShards);
+		for (const TPair<int64, FString>& It : Sized)
+		{
+			int32 Target = 0;
+			for (int32 i = 1; i < NumShards; ++i)
+			{
+				if (Loads[i] < Loads[Target] || (Loads[i] == Loads[Target] && Shards[i].Num() < Shards[Target].Num()))
+				{
+					Target = i;
+				}
+			}
+			Shards[Target].Add(It.Value);
+			Loads[Target] += FMath::Max<int64>(It.Key, 1);
+		}
+		Shards.RemoveAll([](const TArray<FString>& Shard) { return Shard.Num() == 0; });
+		return Shards;
+	}
+
+	// editable actors of the persistent level the rule covers, in a stable order for numbering
+	static TArray<AActor*> GatherActors(ULevel* Level, const FRenameRule& Rule)
+	{
+		TArray<UClass*> Classes;
+		for (const FTopLevelAssetPath& ClassPath : Rule.Classes)
+		{
+			if (UClass* Class = FindObject<UClass>(ClassPath))
+			{
+				Classes.Add(Class);
+			}
+		}
+
+		TArray<AActor*> Actors;
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor || !Actor->IsEditable() || !Actor->IsListedInSceneOutliner()) continue;
+
+			const bool bClassMatches = Rule.Classes.Num() == 0 || Classes.ContainsByPredicate([Actor, &Rule](const UClass* Class)
+			{
+				return Rule.bRecursiveClasses ? Actor->IsA(Class) : Actor->GetClass() == Class;
+			});
+			if (bClassMatches)
+			{
+				Actors.Add(Actor);
+			}
+		}
+
+		Actors.Sort([](const AActor& A, const AActor& B) { return A.GetFName().LexicalLess(B.GetFName()); });
+		return Actors;
+	}
+
+	static void RelabelWorld(UWorld* World, const TArray<FRenameRule>& Rules, bool bDryRun, FMapReport& Report, TSet<UPackage*>& OutDirtyPackages)
+	{
+		for (const FRenameRule& Rule : Rules)
+		{
+			FRenameOptions Options = Rule.Options;
+			Options.bApplyToAssets = false;
+			Options.bApplyToActors = true;
+
+			TArray<AActor*> Actors = GatherActors(World->PersistentLevel, Rule);
+			Report.Actors += Actors.Num();
+
+			TArray<FRenamePreviewItem> Preview = FRenameLogic::GeneratePreviewForActors(Actors, Options);
+			check(Preview.Num() == Actors.Num());
+
+			// without numbering a label does not depend on the position in the batch, unchanged actors drop out
+			if (!Options.bUseNumbering)
+			{
+				int32 Kept = 0;
+				for (int32 i = 0; i < Actors.Num(); ++i)
+				{
+					if (!Preview[i].NewName.Equals(Preview[i].OldName, ESearchCase::CaseSensitive))
+					{
+						Actors[Kept] = Actors[i];
+						Preview[Kept] = MoveTemp(Preview[i]);
+						Kept++;
+					}
+				}
+				Actors.SetNum(Kept);
+				Preview.SetNum(Kept);
+			}
+
+			if (bDryRun)
+			{
+				for (const FRenamePreviewItem& Item : Preview)
+				{
+					UE_LOG(LogTemp, Display, TEXT("%s %s: '%s' -> '%s'"), *Report.Map, *Rule.Name, *Item.OldName, *Item.NewName);
+				}
+				continue;
+			}
+
+			const FRenameBatchResult Result = FRenameLogic::RenameActorsBatch(Actors, Options);
+			Report.Renamed += Result.SuccessCount;
+			Report.Failed += Result.FailureCount;
+
+			// the map package, or the actor's own package in levels that store actors externally
+			for (AActor* Actor : Actors)
+			{
+				OutDirtyPackages.Add(Actor->GetPackage());
+			}
+		}
+	}
+
+	static FMapReport RelabelMap(const FString& MapName, const TArray<FRenameRule>& Rules, bool bDryRun)
+	{
+		const double Start = FPlatformTime::Seconds();
+		FMapReport Report;
+		Report.Map = MapName;
+		Report.Status = TEXT("failed");
+
+		UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			Report.Error = TEXT("could not load the map");
+		}
+		else if (World->IsPartitionedWorld())
+		{
+			// actors of partitioned worlds are streamed by cell and never all loaded with the map
+			Report.Status = TEXT("skipped");
+			Report.Error = TEXT("world partition maps are not supported");
+		}
+		else
+		{
+			// just enough of a world for actor iteration and label events, no physics, navigation or rendering
+			World->AddToRoot();
+			World->WorldType = EWorldType::Editor;
+			if (!World->bIsWorldInitialized)
+			{
+				World->InitWorld(UWorld::InitializationValues()
+					.InitializeScenes(false)
+					.AllowAudioPlayback(false)
+					.RequiresHitProxies(false)
+					.CreatePhysicsScene(false)
+					.CreateNavigation(false)
+					.CreateAISystem(false)
+					.ShouldSimulatePhysics(false)
+					.EnableTraceCollision(false)
+					.CreateFXSystem(false));
+			}
+
+			TSet<UPackage*> DirtyPackages;
+			RelabelWorld(World, Rules, bDryRun, Report, DirtyPackages);
+
+			bool bSaved = true;
+			if (Report.Renamed > 0)
+			{
+				TArray<UPackage*> PackagesToSave = DirtyPackages.Array();
+				TArray<UPackage*> FailedPackages;
+				bSaved = FEditorFileUtils::PromptForCheckoutAndSave(PackagesToSave, true, false, &FailedPackages) == FEditorFileUtils::PR_Success
+					&& FailedPackages.Num() == 0;
+			}
+
+			if (!bSaved)
+			{
+				Report.Error = TEXT("could not save the map");
+			}
+			else if (Report.Failed > 0)
+			{
+				Report.Error = TEXT("some actors were not relabeled");
+			}
+			else
+			{
+				Report.Status = TEXT("relabeled");
+			}
+
+			World->RemoveFromRoot();
+			World->DestroyWorld(false);
+		}
+
+		// unload before the next map so a worker only ever holds one
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		Report.Seconds = FPlatformTime::Seconds() - Start;
+		UE_LOG(LogTemp, Display, TEXT("%s: %s, %d actor(s), %d relabeled, %d failed in %.2f s %s"),
+			*Report.Map, *Report.Status, Report.Actors, Report.Renamed, Report.Failed, Report.Seconds, *Report.Error);
+		return Report;
+	}
+
+	// one worker process and the maps of its shard that have no report yet
+	struct FWorker
+	{
+		int32 Index = 0;
+		int32 Launches = 0;
+		TArray<FString> Pending;
+		FString ReportPath;
+		FProcHandle Proc;
+	};
+}
+
+ULeartesRelabelMapsCommandlet::ULeartesRelabelMapsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 ULeartesRelabelMapsCommandlet::Main(const FString& Params)
+{
+	return FParse::Param(*Params, TEXT("Worker")) ? RunWorker(Params) : RunCoordinator(Params);
+}
+
+int32 ULeartesRelabelMapsCommandlet::RunWorker(const FString& Params)
+{
+	using namespace RelabelMaps;
+
+	FString RulesPath;
+	FString ShardPath;
+	FString ReportPath;
+	int32 MemoryCapMB = 4096;
+	FParse::Value(*Params, TEXT("Rules="), RulesPath);
+	FParse::Value(*Params, TEXT("Shard="), ShardPath);
+	FParse::Value(*Params, TEXT("WorkerReport="), ReportPath);
+	FParse::Value(*Params, TEXT("MemoryCapMB="), MemoryCapMB);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	TArray<FRenameRule> Rules;
+	TArray<FString> Maps;
+	if (!RenameRules::LoadFromFile(RulesPath, false, Rules) || !LoadMapList(ShardPath, Maps))
+	{
+		return 1;
+	}
+
+	const uint64 MemoryCap = uint64(FMath::Max(MemoryCapMB, 1)) * 1024 * 1024;
+	TArray<FMapReport> Reports;
+	for (int32 i = 0; i < Maps.Num(); ++i)
+	{
+		Reports.Add(RelabelMap(Maps[i], Rules, bDryRun));
+
+		// written after every map so the coordinator knows how far a worker got even if it dies
+		if (!WriteReports(ReportPath, Reports))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not write worker report to %s"), *ReportPath);
+			return 1;
+		}
+
+		// memory the engine does not give back after unloading piles up, a fresh process starts clean
+		const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+		if (UsedPhysical > MemoryCap && i + 1 < Maps.Num())
+		{
+			UE_LOG(LogTemp, Display, TEXT("Worker uses %llu MB, over the %d MB cap, stopping with %d map(s) left"),
+				UsedPhysical / (1024 * 1024), MemoryCapMB, Maps.Num() - i - 1);
+			return ExitRestart;
+		}
+	}
+	return 0;
+}
+
+int32 ULeartesRelabelMapsCommandlet::RunCoordinator(const FString& Params)
+{
+	using namespace RelabelMaps;
+
+	FString MapsPath;
+	FString RulesPath;
+	if (!FParse::Value(*Params, TEXT("Maps="), MapsPath) || !FParse::Value(*Params, TEXT("Rules="), RulesPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=LeartesRelabelMaps -Maps=Maps.txt -Rules=Rules.json [-Workers=N] [-MemoryCapMB=4096] [-DryRun] [-Report=Report.json]"));
+		return 1;
+	}
+	MapsPath = FPaths::ConvertRelativePathToFull(MapsPath);
+	RulesPath = FPaths::ConvertRelativePathToFull(RulesPath);
+
+	int32 MemoryCapMB = 4096;
+	FParse::Value(*Params, TEXT("MemoryCapMB="), MemoryCapMB);
+	MemoryCapMB = FMath::Max(MemoryCapMB, 1);
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+
+	// catch a bad rules file here instead of in every worker
+	TArray<FRenameRule> Rules;
+	TArray<FString> Maps;
+	if (!RenameRules::LoadFromFile(RulesPath, false, Rules) || !LoadMapList(MapsPath, Maps))
+	{
+		return 1;
+	}
+	if (Maps.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Map list %s is empty"), *MapsPath);
+		return 1;
+	}
+	for (const FRenameRule& Rule : Rules)
+	{
+		if (Rule.Paths.Num() > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: content paths do not apply to actor labels and are ignored"), *Rule.Name);
+		}
+	}
+
+	// one worker per core by default, as many as fit into the free memory at the cap each
+	const uint64 AvailableMB = FPlatformMemory::GetStats().AvailablePhysical / (1024 * 1024);
+	int32 NumWorkers = FMath::Min(FPlatformMisc::NumberOfCores(), int32(FMath::Max<uint64>(AvailableMB / MemoryCapMB, 1)));
+	FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+	NumWorkers = FMath::Clamp(NumWorkers, 1, Maps.Num());
+
+	const FString WorkDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("LeartesRename") / FString::Printf(TEXT("Relabel-%s"), *FDateTime::Now().ToString()));
+	const FString ProjectPath = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+
+	const double Start = FPlatformTime::Seconds();
+	TArray<FMapReport> Reports;
+	TArray<FWorker> Workers;
+	for (TArray<FString>& Shard : MakeShards(Maps, NumWorkers))
+	{
+		FWorker& Worker = Workers.AddDefaulted_GetRef();
+		Worker.Index = Workers.Num() - 1;
+		Worker.Pending = MoveTemp(Shard);
+	}
+
+	auto FailPending = [&Reports](FWorker& Worker, int32 Count, const FString& Error)
+	{
+		for (int32 i = 0; i < Count && Worker.Pending.Num() > 0; ++i)
+		{
+			FMapReport& Report = Reports.AddDefaulted_GetRef();
+			Report.Map = Worker.Pending[0];
+			Report.Status = TEXT("failed");
+			Report.Error = Error;
+			Worker.Pending.RemoveAt(0);
+		}
+	};
+
+	auto LaunchWorker = [&](FWorker& Worker)
+	{
+		const FString Name = FString::Printf(TEXT("Worker%d-%d"), Worker.Index, Worker.Launches++);
+		const FString ShardPath = WorkDir / Name + TEXT(".txt");
+		Worker.ReportPath = WorkDir / Name + TEXT(".json");
+
+		if (!WriteMapList(ShardPath, Worker.Pending))
+		{
+			FailPending(Worker, Worker.Pending.Num(), FString::Printf(TEXT("could not write %s"), *ShardPath));
+			return;
+		}
+
+		const FString Args = FString::Printf(TEXT("\"%s\" -run=LeartesRelabelMaps -Worker -Rules=\"%s\" -Shard=\"%s\" -WorkerReport=\"%s\" -MemoryCapMB=%d%s -unattended -nullrhi -nosplash -nosound -abslog=\"%s\""),
+			*ProjectPath, *RulesPath, *ShardPath, *Worker.ReportPath, MemoryCapMB, bDryRun ? TEXT(" -DryRun") : TEXT(""), *(WorkDir / Name + TEXT(".log")));
+
+		Worker.Proc = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Args, false, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Worker.Proc.IsValid())
+		{
+			FailPending(Worker, Worker.Pending.Num(), TEXT("could not start a worker process"));
+			return;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Started %s with %d map(s)"), *Name, Worker.Pending.Num());
+	};
+
+	UE_LOG(LogTemp, Display, TEXT("Relabeling %d map(s) with %d worker(s), %d MB memory cap each, logs in %s"), Maps.Num(), Workers.Num(), MemoryCapMB, *WorkDir);
+	for (FWorker& Worker : Workers)
+	{
+		LaunchWorker(Worker);
+	}
+
+	for (bool bRunning = true; bRunning; )
+	{
+		FPlatformProcess::Sleep(0.25f);
+		bRunning = false;
+
+		for (FWorker& Worker : Workers)
+		{
+			if (!Worker.Proc.IsValid()) continue;
+			if (FPlatformProcess::IsProcRunning(Worker.Proc))
+			{
+				bRunning = true;
+				continue;
+			}
+
+			int32 ReturnCode = -1;
+			FPlatformProcess::GetProcReturnCode(Worker.Proc, &ReturnCode);
+			FPlatformProcess::CloseProc(Worker.Proc);
+
+			const int32 NumPendingBefore = Worker.Pending.Num();
+			for (FMapReport& Report : ReadReports(Worker.ReportPath))
+			{
+				Worker.Pending.Remove(Report.Map);
+				Reports.Add(MoveTemp(Report));
+			}
+
+			// a worker that died was working on the first map it did not report, the rest gets a new worker;
+			// one that reported nothing would do the same again, so that map is failed too
+			if (ReturnCode != 0 && ReturnCode != ExitRestart)
+			{
+				FailPending(Worker, 1, FString::Printf(TEXT("worker exited with code %d while relabeling"), ReturnCode));
+			}
+			else if (Worker.Pending.Num() > 0 && Worker.Pending.Num() == NumPendingBefore)
+			{
+				FailPending(Worker, 1, FString::Printf(TEXT("worker exited with code %d without reporting any map"), ReturnCode));
+			}
+			if (Worker.Pending.Num() > 0)
+			{
+				LaunchWorker(Worker);
+				bRunning |= Worker.Proc.IsValid();
+			}
+		}
+	}
+
+	Reports.Sort([](const FMapReport& A, const FMapReport& B) { return A.Map < B.Map; });
+
+	int32 NumRelabeled = 0;
+	int32 NumSkipped = 0;
+	int32 NumFailed = 0;
+	int32 NumActorsRenamed = 0;
+	for (const FMapReport& Report : Reports)
+	{
+		NumActorsRenamed += Report.Renamed;
+		if (Report.Status == TEXT("relabeled"))
+		{
+			NumRelabeled++;
+		}
+		else if (Report.Status == TEXT("skipped"))
+		{
+			NumSkipped++;
+			UE_LOG(LogTemp, Warning, TEXT("Skipped %s: %s"), *Report.Map, *Report.Error);
+		}
+		else
+		{
+			NumFailed++;
+			UE_LOG(LogTemp, Error, TEXT("Failed %s: %s"), *Report.Map, *Report.Error);
+		}
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - Start;
+	TSharedRef<FJsonObject> Totals = MakeShared<FJsonObject>();
+	Totals->SetBoolField(TEXT("dryRun"), bDryRun);
+	Totals->SetNumberField(TEXT("workers"), Workers.Num());
+	Totals->SetNumberField(TEXT("relabeled"), NumRelabeled);
+	Totals->SetNumberField(TEXT("skipped"), NumSkipped);
+	Totals->SetNumberField(TEXT("failed"), NumFailed);
+	Totals->SetNumberField(TEXT("actorsRenamed"), NumActorsRenamed);
+	Totals->SetNumberField(TEXT("seconds"), Seconds);
+
+	FString ReportPath = WorkDir / TEXT("Report.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+	if (!WriteReports(ReportPath, Reports, Totals))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write relabel report to %s"), *ReportPath);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("LeartesRelabelMaps %s: %d map(s) relabeled, %d skipped, %d failed, %d actor(s) renamed with %d worker(s) in %.1f s, report in %s"),
+		bDryRun ? TEXT("dry run") : TEXT("apply"), NumRelabeled, NumSkipped, NumFailed, NumActorsRenamed, Workers.Num(), Seconds, *ReportPath);
+
+	return NumFailed == 0 ? 0 : 1;
+}
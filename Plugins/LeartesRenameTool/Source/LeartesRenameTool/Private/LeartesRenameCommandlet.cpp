@@ -0,0 +1,262 @@
+#include "LeartesRenameCommandlet.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "RenameLogic.h"
+#include "RenameRules.h"
+#include "RenameTypes.h"
+
+namespace RenameCommandlet
+{
+	struct FRuleSummary
+	{
+		FString Name;
+		int32 Matched = 0;
+		int32 Unchanged = 0;
+		int32 Collisions = 0;
+		int32 Duplicates = 0;
+		int32 Renamed = 0;
+		int32 Failed = 0;
+		// redirector fixup, when the rule asked for it
+		int32 FixedUpPackages = 0;
+		int32 DeletedRedirectors = 0;
+		double Seconds = 0.0;
+		// options of the rule the run did not honor, and why
+		TArray<FString> Warnings;
+	};
+
+	// preview, then apply unless dry run, the rule sees the names earlier rules produced
+	// without bSave nothing reaches the disk, so the fixup, which saves every package it touches, is turned off
+	static FRuleSummary RunRule(IAssetRegistry& AssetRegistry, const FRenameRule& Rule, bool bDryRun, bool bSave)
+	{
+		const double Start = FPlatformTime::Seconds();
+		FRuleSummary Summary;
+		Summary.Name = Rule.Name;
+
+		FARFilter Filter;
+		Filter.PackagePaths = Rule.Paths;
+		Filter.bRecursivePaths = Rule.bRecursivePaths;
+		Filter.ClassPaths = Rule.Classes;
+		Filter.bRecursiveClasses = Rule.bRecursiveClasses;
+
+		// assets only, renamed in one AssetTools call
+		FRenameOptions Options = Rule.Options;
+		Options.bApplyToAssets = true;
+		Options.bApplyToActors = false;
+		Options.bBulkAssetRename = true;
+		// the commandlet saves once after all rules, or not at all with -NoSave
+		Options.bSaveOnApply = false;
+		if (Options.bFixupRedirectors && !bSave && !bDryRun)
+		{
+			Options.bFixupRedirectors = false;
+			Summary.Warnings.Add(TEXT("fixupRedirectors ignored, it saves packages and -NoSave is set"));
+			UE_LOG(LogTemp, Warning, TEXT("%s: %s"), *Rule.Name, *Summary.Warnings.Last());
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(Filter, Assets);
+		Assets.RemoveAll([](const FAssetData& AD) { return AD.IsRedirector(); });
+
+		// registry order depends on the scan, sorting keeps the numbering the same on every run
+		Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+		Summary.Matched = Assets.Num();
+
+		TArray<FRenamePreviewItem> Preview = FRenameLogic::GeneratePreviewForAssets(Assets, Options);
+		check(Preview.Num() == Assets.Num());
+
+		// without numbering a name does not depend on the position in the batch,
+		// so assets the rule leaves as they are drop out instead of failing as a rename onto themselves
+		if (!Options.bUseNumbering)
+		{
+			int32 Kept = 0;
+			for (int32 i = 0; i < Assets.Num(); ++i)
+			{
+				if (Preview[i].NewName.Equals(Preview[i].OldName, ESearchCase::CaseSensitive))
+				{
+					continue;
+				}
+				if (Kept != i)
+				{
+					Assets[Kept] = MoveTemp(Assets[i]);
+					Preview[Kept] = MoveTemp(Preview[i]);
+				}
+				Kept++;
+			}
+			Summary.Unchanged = Assets.Num() - Kept;
+			Assets.SetNum(Kept);
+			Preview.SetNum(Kept);
+		}
+
+		for (const FRenamePreviewItem& Item : Preview)
+		{
+			if (Item.bCollision)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s: '%s' -> '%s' collides with an existing asset"), *Rule.Name, *Item.OldName, *Item.NewName);
+				Summary.Collisions++;
+			}
+			if (Item.bBatchDuplicate)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s: '%s' -> '%s' is also the new name of another asset"), *Rule.Name, *Item.OldName, *Item.NewName);
+				Summary.Duplicates++;
+			}
+			if (bDryRun)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s: '%s' -> '%s'"), *Rule.Name, *Item.OldName, *Item.NewName);
+			}
+		}
+
+		if (!bDryRun && Assets.Num() > 0)
+		{
+			const FRenameBatchResult Result = FRenameLogic::RenameAssetsBatch(Assets, Options);
+			Summary.Renamed = Result.SuccessCount;
+			Summary.Failed = Result.FailureCount;
+			Summary.FixedUpPackages = Result.FixedUpPackages;
+			Summary.DeletedRedirectors = Result.DeletedRedirectors;
+		}
+
+		Summary.Seconds = FPlatformTime::Seconds() - Start;
+		return Summary;
+	}
+
+	// renamed packages, the redirectors left behind and the fixed up referencers
+	static bool SaveDirtyPackages()
+	{
+		TArray<UPackage*> Packages;
+		FEditorFileUtils::GetDirtyContentPackages(Packages);
+		FEditorFileUtils::GetDirtyWorldPackages(Packages);
+
+		// the untitled commandlet world has nowhere to be saved
+		Packages.RemoveAll([](const UPackage* Package) { return FPackageName::IsTempPackage(Package->GetName()); });
+		if (Packages.Num() == 0)
+		{
+			return true;
+		}
+
+		TArray<UPackage*> FailedPackages;
+		const FEditorFileUtils::EPromptReturnCode SaveResult = FEditorFileUtils::PromptForCheckoutAndSave(Packages, true, false, &FailedPackages);
+		for (const UPackage* Package : FailedPackages)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not save %s"), *Package->GetName());
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Saved %d of %d package(s)"), Packages.Num() - FailedPackages.Num(), Packages.Num());
+		return SaveResult == FEditorFileUtils::PR_Success && FailedPackages.Num() == 0;
+	}
+
+	static void WriteReport(const FString& Path, const TArray<FRuleSummary>& Summaries, bool bDryRun, bool bSaved)
+	{
+		TArray<TSharedPtr<FJsonValue>> Rules;
+		for (const FRuleSummary& Summary : Summaries)
+		{
+			TSharedRef<FJsonObject> Rule = MakeShared<FJsonObject>();
+			Rule->SetStringField(TEXT("name"), Summary.Name);
+			Rule->SetNumberField(TEXT("matched"), Summary.Matched);
+			Rule->SetNumberField(TEXT("unchanged"), Summary.Unchanged);
+			Rule->SetNumberField(TEXT("collisions"), Summary.Collisions);
+			Rule->SetNumberField(TEXT("duplicates"), Summary.Duplicates);
+			Rule->SetNumberField(TEXT("renamed"), Summary.Renamed);
+			Rule->SetNumberField(TEXT("failed"), Summary.Failed);
+			Rule->SetNumberField(TEXT("fixedUpPackages"), Summary.FixedUpPackages);
+			Rule->SetNumberField(TEXT("deletedRedirectors"), Summary.DeletedRedirectors);
+			Rule->SetNumberField(TEXT("seconds"), Summary.Seconds);
+
+			TArray<TSharedPtr<FJsonValue>> Warnings;
+			for (const FString& Warning : Summary.Warnings)
+			{
+				Warnings.Add(MakeShared<FJsonValueString>(Warning));
+			}
+			Rule->SetArrayField(TEXT("warnings"), Warnings);
+			Rules.Add(MakeShared<FJsonValueObject>(Rule));
+		}
+
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetBoolField(TEXT("dryRun"), bDryRun);
+		Report->SetBoolField(TEXT("saved"), bSaved);
+		Report->SetArrayField(TEXT("rules"), Rules);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Report, Writer);
+
+		if (!FFileHelper::SaveStringToFile(Json, *Path))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not write rename report to %s"), *Path);
+		}
+	}
+}
+
+ULeartesRenameCommandlet::ULeartesRenameCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 ULeartesRenameCommandlet::Main(const FString& Params)
+{
+	using namespace RenameCommandlet;
+
+	FString RulesPath;
+	if (!FParse::Value(*Params, TEXT("Rules="), RulesPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=LeartesRename -Rules=Rules.json [-DryRun] [-NoSave] [-Report=Report.json]"));
+		UE_LOG(LogTemp, Error, TEXT("-NoSave leaves every package unsaved and turns off the fixupRedirectors option of the rules, which would save"));
+		return 1;
+	}
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+	const bool bSave = !bDryRun && !FParse::Param(*Params, TEXT("NoSave"));
+	FString ReportPath;
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+
+	TArray<FRenameRule> Rules;
+	if (!RenameRules::LoadFromFile(RulesPath, true, Rules))
+	{
+		return 1;
+	}
+
+	// the registry is not gathered in a commandlet, scan once up front instead of waiting per rule
+	const double Start = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FRuleSummary> Summaries;
+	int32 TotalRenamed = 0;
+	int32 TotalFailed = 0;
+	for (const FRenameRule& Rule : Rules)
+	{
+		const FRuleSummary& Summary = Summaries.Add_GetRef(RunRule(AssetRegistry, Rule, bDryRun, bSave));
+		TotalRenamed += Summary.Renamed;
+		TotalFailed += Summary.Failed;
+	}
+
+	const bool bSaved = !bSave || TotalRenamed == 0 || SaveDirtyPackages();
+
+	UE_LOG(LogTemp, Display, TEXT("%-32s %8s %9s %10s %10s %8s %7s %8s"),
+		TEXT("rule"), TEXT("matched"), TEXT("unchanged"), TEXT("collisions"), TEXT("duplicates"), TEXT("renamed"), TEXT("failed"), TEXT("seconds"));
+	for (const FRuleSummary& Summary : Summaries)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%-32s %8d %9d %10d %10d %8d %7d %8.2f"),
+			*Summary.Name, Summary.Matched, Summary.Unchanged, Summary.Collisions, Summary.Duplicates, Summary.Renamed, Summary.Failed, Summary.Seconds);
+	}
+	UE_LOG(LogTemp, Display, TEXT("LeartesRename %s: %d rule(s), %d renamed, %d failed%s in %.2f s"),
+		bDryRun ? TEXT("dry run") : TEXT("apply"), Rules.Num(), TotalRenamed, TotalFailed,
+		bSaved ? TEXT("") : TEXT(", save failed"), FPlatformTime::Seconds() - Start);
+
+	if (!ReportPath.IsEmpty())
+	{
+		WriteReport(ReportPath, Summaries, bDryRun, bSave && bSaved);
+	}
+
+	return (TotalFailed == 0 && bSaved) ? 0 : 1;
+}
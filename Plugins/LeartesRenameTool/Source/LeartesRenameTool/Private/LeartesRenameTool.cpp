@@ -8,6 +8,13 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "ToolMenus.h"
+#include "RenameLogic.h"
+#include "ActorLabelIndex.h"
+#include "AssetNameIndex.h"
+#include "RenameJournal.h"
+#include "Editor.h"
+#include "Misc/MessageDialog.h"
+#include "Algo/Count.h"
 
 static const FName LeartesRenameToolTabName("LeartesRenameTool");
 
@@ -21,6 +28,10 @@ void FLeartesRenameToolModule::StartupModule()
 	FLeartesRenameToolStyle::Initialize();
 	FLeartesRenameToolStyle::ReloadTextures();
 
+	// shared name indexes used by actor and asset collision checks
+	FActorLabelIndex::Initialize();
+	FAssetNameIndex::Initialize();
+
 	//register UI commands
 	FLeartesRenameToolCommands::Register();
 	
@@ -39,6 +50,12 @@ void FLeartesRenameToolModule::StartupModule()
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(LeartesRenameToolTabName, FOnSpawnTab::CreateRaw(this, &FLeartesRenameToolModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FLeartesRenameToolTabTitle", "LeartesRenameTool"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	// an unfinished rename batch is offered once the editor is up and assets can be loaded
+	if (!IsRunningCommandlet())
+	{
+		EditorInitializedHandle = FEditorDelegates::OnEditorInitialized.AddRaw(this, &FLeartesRenameToolModule::OfferJournalRecovery);
+	}
 }
 
 //Clean up registrations during shutdown or module unload
@@ -46,6 +63,13 @@ void FLeartesRenameToolModule::ShutdownModule()
 {
 	
 
+	FEditorDelegates::OnEditorInitialized.Remove(EditorInitializedHandle);
+
+	// stop background registry updates before the module code goes away
+	FRenameLogic::CancelDeferredRegistryUpdate();
+	FActorLabelIndex::Shutdown();
+	FAssetNameIndex::Shutdown();
+
 	UToolMenus::UnRegisterStartupCallback(this);
 
 	UToolMenus::UnregisterOwner(this);
@@ -68,6 +92,39 @@ TSharedRef<SDockTab> FLeartesRenameToolModule::OnSpawnPluginTab(const FSpawnTabA
 		];
 }
 
+//Yes resumes, No rolls back, Cancel keeps the journal for the next start
+void FLeartesRenameToolModule::OfferJournalRecovery(double Duration)
+{
+	if (!FRenameJournal::HasPendingJournal()) return;
+
+	const TArray<FRenameJournal::FEntry> Entries = FRenameJournal::ReadPendingJournal();
+	const int32 NumDone = Algo::CountIf(Entries, [](const FRenameJournal::FEntry& Entry) { return Entry.State == FRenameJournal::EState::Done; });
+	const int32 NumDuplicated = Algo::CountIf(Entries, [](const FRenameJournal::FEntry& Entry) { return Entry.State == FRenameJournal::EState::Duplicated; });
+	if (Entries.Num() == 0)
+	{
+		// unreadable, or cut short before any asset moved
+		FRenameJournal::Discard();
+		return;
+	}
+
+	// a duplicated item has a copy under its new name that either choice removes
+	const FText Message = FText::Format(LOCTEXT("JournalRecoveryMessage",
+		"An asset rename batch did not finish: {0} of {1} assets were renamed, {3} more were saved under their new name without their redirector.\n\nYes: rename the remaining {2} assets\nNo: rename the {0} renamed assets back\nCancel: decide on the next start"),
+		NumDone, Entries.Num(), Entries.Num() - NumDone, NumDuplicated);
+
+	switch (FMessageDialog::Open(EAppMsgType::YesNoCancel, Message, LOCTEXT("JournalRecoveryTitle", "Unfinished Rename")))
+	{
+	case EAppReturnType::Yes:
+		FRenameJournal::Resume();
+		break;
+	case EAppReturnType::No:
+		FRenameJournal::Rollback();
+		break;
+	default:
+		break;
+	}
+}
+
 //bring up the plugin tab on clicked
 void FLeartesRenameToolModule::PluginButtonClicked()
 {
@@ -7,6 +7,7 @@
 #include "Slate/SlateGameResources.h"
 #include "Interfaces/IPluginManager.h"
 #include "Styling/SlateStyleMacros.h"
+#include "Styling/AppStyle.h"
 
 #define RootToContentDir Style->RootToContentDir
 
@@ -48,6 +49,13 @@ TSharedRef< FSlateStyleSet > FLeartesRenameToolStyle::Create()
 	//map key name to image
 	Style->Set("LeartesRenameTool.OpenPluginWindow", new IMAGE_BRUSH_SVG(TEXT("PlaceholderButtonIcon"), Icon20x20));
 
+	//preview diff highlighting, the tags of the rich text in the preview rows
+	const FTextBlockStyle NormalText = FAppStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText");
+	Style->Set("LeartesRenameTool.Diff.Normal", NormalText);
+	Style->Set("LeartesRenameTool.Diff.Removed", FTextBlockStyle(NormalText).SetColorAndOpacity(FLinearColor(1.f, 0.35f, 0.3f)));
+	Style->Set("LeartesRenameTool.Diff.Inserted", FTextBlockStyle(NormalText).SetColorAndOpacity(FLinearColor(0.35f, 0.9f, 0.4f)));
+	Style->Set("LeartesRenameTool.Diff.Replaced", FTextBlockStyle(NormalText).SetColorAndOpacity(FLinearColor(1.f, 0.75f, 0.2f)));
+
 	return Style;
 }
 
@@ -0,0 +1,146 @@
+#include "RenameBenchmarkHelpers.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Curves/CurveFloat.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace RenameBenchmarks
+{
+	TArray<FString> MakeNameCorpus(int32 Count)
+	{
+		static const TCHAR* Stems[] =
+		{
+			TEXT("SM_Rock"), TEXT("Tex_Ground_Diffuse"), TEXT("Mat_Wall_Brick_Old"), TEXT("BP_Door"),
+			TEXT("Chair"), TEXT("SK_Mannequin_Arms_Long"), TEXT("Fx_Smoke_Plume_Large_Dense"), TEXT("Lamp")
+		};
+
+		FRandomStream Random(1234);
+		TArray<FString> Names;
+		Names.Reserve(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Names.Add(FString::Printf(TEXT("%s_%d"), Stems[Random.RandHelper(UE_ARRAY_COUNT(Stems))], Random.RandRange(0, 99999)));
+		}
+		return Names;
+	}
+
+	TArray<FAssetData> MakeSyntheticAssets(const TArray<FString>& Names, FName PackagePath)
+	{
+		const FTopLevelAssetPath ClassPath(FName(TEXT("/Script/Engine")), FName(TEXT("StaticMesh")));
+
+		TArray<FAssetData> Assets;
+		Assets.Reserve(Names.Num());
+		for (const FString& Name : Names)
+		{
+			const FName PackageName(*(PackagePath.ToString() / Name));
+			Assets.Emplace(PackageName, PackagePath, FName(*Name), ClassPath);
+		}
+		return Assets;
+	}
+
+	TArray<FAssetData> CreateTransientAssets(const TArray<FString>& Corpus, const FString& PackagePath)
+	{
+		TArray<FAssetData> Assets;
+		Assets.Reserve(Corpus.Num());
+		for (int32 i = 0; i < Corpus.Num(); ++i)
+		{
+			const FString AssetName = FString::Printf(TEXT("%s_%d"), *Corpus[i], i);
+			UPackage* Package = CreatePackage(*(PackagePath / AssetName));
+			UCurveFloat* Asset = NewObject<UCurveFloat>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+			FAssetRegistryModule::AssetCreated(Asset);
+			Assets.Emplace(Asset);
+		}
+		return Assets;
+	}
+
+	void DestroyTransientAssets(const FString& RootPath)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		TArray<FAssetData> Leftovers;
+		AssetRegistry.GetAssetsByPath(FName(*RootPath), Leftovers, true, false);
+
+		for (const FAssetData& AD : Leftovers)
+		{
+			UObject* Asset = AD.FastGetAsset(false);
+			if (!Asset) continue;
+
+			FAssetRegistryModule::AssetDeleted(Asset);
+			Asset->ClearFlags(RF_Public | RF_Standalone);
+			Asset->MarkAsGarbage();
+			Asset->GetPackage()->SetDirtyFlag(false);
+		}
+	}
+
+	UWorld* CreateScratchWorld(const TCHAR* Name)
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, Name);
+		FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Editor);
+		Context.SetCurrentWorld(World);
+		return World;
+	}
+
+	void DestroyScratchWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	TArray<AActor*> SpawnLabeledActors(UWorld* World, const TArray<FString>& Labels)
+	{
+		TArray<AActor*> Actors;
+		Actors.Reserve(Labels.Num());
+		for (const FString& Label : Labels)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			Actor->SetActorLabel(Label);
+			Actors.Add(Actor);
+		}
+		return Actors;
+	}
+
+	// large enough that a 100k item batch is never trimmed away before it is undone
+	static constexpr SIZE_T ScratchTransactorMemory = SIZE_T(1024) * 1024 * 1024;
+
+	FScopedScratchTransactor::FScopedScratchTransactor()
+	{
+		check(GEditor && !GEditor->IsTransactionActive());
+
+		Scratch = NewObject<UTransBuffer>(GetTransientPackage());
+		Scratch->AddToRoot();
+		Scratch->Initialize(ScratchTransactorMemory);
+
+		Previous = GEditor->Trans;
+		GEditor->Trans = Scratch;
+	}
+
+	FScopedScratchTransactor::~FScopedScratchTransactor()
+	{
+		Scratch->Reset(FText::FromString(TEXT("Scratch transactor")));
+		GEditor->Trans = Previous;
+		Scratch->RemoveFromRoot();
+		Scratch->MarkAsGarbage();
+	}
+
+#if MALLOC_GT_HOOKS
+	// hook index 0 is a malloc and 1 a realloc, which may move the block, 2 is a free
+	FScopedAllocationCounter::FScopedAllocationCounter()
+		: Hook([this](int32 Index) { Count += Index < 2 ? 1 : 0; })
+	{
+		check(IsInGameThread());
+		PreviousHook = GGameThreadMallocHook;
+		GGameThreadMallocHook = &Hook;
+	}
+
+	FScopedAllocationCounter::~FScopedAllocationCounter()
+	{
+		GGameThreadMallocHook = PreviousHook;
+	}
+#endif
+}
@@ -0,0 +1,88 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "RenameBenchmarkHelpers.h"
+#include "RenameNamePlan.h"
+#include "RenameNameReference.h"
+#include "RenameTypes.h"
+
+//console benchmarks for the rename kernels
+//run from the editor console or headless with -ExecCmds="LeartesRename.BenchmarkNames 1000000"
+//allocation counts and the preview and apply timings at scale are automation tests, see Private/Tests
+
+namespace RenameBenchmarks
+{
+	static void RunNameBenchmark(const TArray<FString>& Args)
+	{
+		int32 Count = 1000000;
+		if (Args.Num() > 0)
+		{
+			LexFromString(Count, *Args[0]);
+		}
+		Count = FMath::Max(1, Count);
+
+		const TArray<FString> Corpus = MakeNameCorpus(Count);
+		UE_LOG(LogTemp, Display, TEXT("Name generation benchmark over %d names"), Count);
+
+		// every combination of find, case and numbering, always with a prefix and suffix
+		for (int32 Mask = 0; Mask < 8; ++Mask)
+		{
+			FRenameOptions Options;
+			Options.Prefix = TEXT("P_");
+			Options.Suffix = TEXT("_S");
+			Options.Find = (Mask & 4) ? TEXT("_") : TEXT("");
+			Options.Replace = TEXT("-");
+			Options.CaseOp = (Mask & 2) ? ECaseOp::Upper : ECaseOp::None;
+			Options.bUseNumbering = (Mask & 1) != 0;
+			Options.Padding = 4;
+
+			int64 Checksum = 0;
+
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Checksum += RenameNameReference::GenerateNewName(Corpus[i], Options, i).Len();
+			}
+			const double LegacySeconds = FPlatformTime::Seconds() - Start;
+
+			// plan writing a fresh string per name, which is what a stored preview pays
+			Start = FPlatformTime::Seconds();
+			const FRenameNamePlan Plan(Options);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Checksum += Plan.Generate(Corpus[i], i).Len();
+			}
+			const double PlanSeconds = FPlatformTime::Seconds() - Start;
+
+			// plan reusing one buffer, the raw kernel throughput
+			Start = FPlatformTime::Seconds();
+			FString Buffer;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plan.Generate(Corpus[i], i, Buffer);
+				Checksum += Buffer.Len();
+			}
+			const double KernelSeconds = FPlatformTime::Seconds() - Start;
+
+			// spot check the plan against the legacy output
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < Count; i += 997)
+			{
+				if (!Plan.Generate(Corpus[i], i).Equals(RenameNameReference::GenerateNewName(Corpus[i], Options, i), ESearchCase::CaseSensitive))
+				{
+					Mismatches++;
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("  find=%d case=%d number=%d: legacy %.1f ms, plan %.1f ms (%.1fx), plan reused buffer %.1f ms (%.1fx), mismatches %d, checksum %lld"),
+				(Mask >> 2) & 1, (Mask >> 1) & 1, Mask & 1,
+				LegacySeconds * 1000.0, PlanSeconds * 1000.0, LegacySeconds / FMath::Max(PlanSeconds, 1e-9),
+				KernelSeconds * 1000.0, LegacySeconds / FMath::Max(KernelSeconds, 1e-9), Mismatches, Checksum);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkNamesCommand(
+		TEXT("LeartesRename.BenchmarkNames"),
+		TEXT("Times the legacy and compiled name generation over a synthetic corpus. Usage: LeartesRename.BenchmarkNames [Count]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunNameBenchmark));
+}
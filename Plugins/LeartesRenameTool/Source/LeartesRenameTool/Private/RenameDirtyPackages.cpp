@@ -0,0 +1,145 @@
+#include "RenameDirtyPackages.h"
+#include "FileHelpers.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+// packages per concurrent save, each chunk is one step of the progress dialog
+static constexpr int32 ConcurrentSaveChunkSize = 32;
+
+static void GetDirtyPackages(TArray<UPackage*>& OutPackages)
+{
+	FEditorFileUtils::GetDirtyContentPackages(OutPackages);
+	FEditorFileUtils::GetDirtyWorldPackages(OutPackages);
+}
+
+void FRenameDirtyPackages::Begin()
+{
+	TArray<UPackage*> Packages;
+	GetDirtyPackages(Packages);
+
+	DirtyBefore.Reset();
+	DirtyBefore.Reserve(Packages.Num());
+	for (UPackage* Package : Packages)
+	{
+		DirtyBefore.Add(Package);
+	}
+	Changed.Reset();
+	First.Reset();
+}
+
+void FRenameDirtyPackages::Add(UPackage* Package, bool bFirst)
+{
+	if (Package)
+	{
+		Changed.Add(Package);
+		if (bFirst)
+		{
+			First.Add(Package);
+		}
+	}
+}
+
+static void SavePackages(const TArray<UPackage*>& Packages, FRenameBatchResult& Result)
+{
+	if (Packages.Num() == 0) return;
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_NoError;
+
+	// the concurrent save handles plain content packages, maps and their external packages go through the serial path
+	TArray<FPackageSaveInfo> ConcurrentPackages;
+	TArray<FPackageSaveInfo> SerialPackages;
+	for (UPackage* Package : Packages)
+	{
+		FPackageSaveInfo& Info = (Package->ContainsMap() || Package->HasAnyPackageFlags(PKG_ContainsMapData)) ? SerialPackages.AddDefaulted_GetRef() : ConcurrentPackages.AddDefaulted_GetRef();
+		Info.Package = Package;
+		Info.Asset = Package->FindAssetInPackage();
+		const FString& Extension = Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+		Info.Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), Extension);
+	}
+
+	const int32 NumConcurrentChunks = FMath::DivideAndRoundUp(ConcurrentPackages.Num(), ConcurrentSaveChunkSize);
+	FScopedSlowTask SlowTask(NumConcurrentChunks + SerialPackages.Num(), FText::FromString(TEXT("Saving renamed packages...")));
+	SlowTask.MakeDialogDelayed(1.0f);
+
+	auto Report = [&Result](const FPackageSaveInfo& Info, ESavePackageResult SaveResult)
+	{
+		if (SaveResult == ESavePackageResult::Success)
+		{
+			Result.SavedPackages++;
+			return;
+		}
+		UE_LOG(LogTemp, Error, TEXT("Could not save %s (%s)"), *Info.Package->GetName(), *Info.Filename);
+		Result.SaveFailures.Add(Info.Package->GetName());
+	};
+
+	TArray<FSavePackageResultStruct> Results;
+	for (int32 ChunkStart = 0; ChunkStart < ConcurrentPackages.Num(); ChunkStart += ConcurrentSaveChunkSize)
+	{
+		SlowTask.EnterProgressFrame(1);
+
+		TArrayView<FPackageSaveInfo> Chunk = MakeArrayView(ConcurrentPackages).Mid(ChunkStart, ConcurrentSaveChunkSize);
+		for (const FPackageSaveInfo& Info : Chunk)
+		{
+			Info.Package->FullyLoad();
+		}
+
+		Results.Reset();
+		UPackage::SaveConcurrent(Chunk, SaveArgs, Results);
+		for (int32 i = 0; i < Chunk.Num(); ++i)
+		{
+			Report(Chunk[i], Results.IsValidIndex(i) ? Results[i].Result : ESavePackageResult::Error);
+		}
+	}
+
+	for (const FPackageSaveInfo& Info : SerialPackages)
+	{
+		SlowTask.EnterProgressFrame(1);
+		Report(Info, UPackage::Save(Info.Package, Info.Asset, *Info.Filename, SaveArgs).Result);
+	}
+}
+
+void FRenameDirtyPackages::Save(FRenameBatchResult& Result)
+{
+	const double Start = FPlatformTime::Seconds();
+
+	TArray<UPackage*> Packages;
+	GetDirtyPackages(Packages);
+	Packages.RemoveAll([this](const UPackage* Package)
+	{
+		return (DirtyBefore.Contains(Package) && !Changed.Contains(Package)) || FPackageName::IsTempPackage(Package->GetName());
+	});
+	if (Packages.Num() == 0) return;
+
+	TArray<UPackage*> FirstPackages;
+	for (int32 i = Packages.Num() - 1; i >= 0; --i)
+	{
+		if (First.Contains(Packages[i]))
+		{
+			FirstPackages.Add(Packages[i]);
+			Packages.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+
+	const int32 NumFailuresBefore = Result.SaveFailures.Num();
+	SavePackages(FirstPackages, Result);
+	if (Result.SaveFailures.Num() == NumFailuresBefore)
+	{
+		SavePackages(Packages, Result);
+	}
+	else
+	{
+		// what depends on the first pass must not reach the disk without it
+		UE_LOG(LogTemp, Error, TEXT("Not saving %d more package(s) because %d package(s) saved ahead of them failed"), Packages.Num(), Result.SaveFailures.Num() - NumFailuresBefore);
+		for (const UPackage* Package : Packages)
+		{
+			Result.SaveFailures.Add(Package->GetName());
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Saved %d of %d package(s) dirtied by the rename in %.2f s"), Result.SavedPackages, FirstPackages.Num() + Packages.Num(), FPlatformTime::Seconds() - Start);
+}
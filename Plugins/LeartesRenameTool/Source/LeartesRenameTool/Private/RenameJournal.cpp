@@ -0,0 +1,333 @@
+#include "RenameJournal.h"
+#include "RenameDirtyPackages.h"
+#include "AssetToolsModule.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "IAssetTools.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UObjectGlobals.h"
+
+static const TCHAR* JournalHeader = TEXT("LeartesRenameJournal");
+
+FRenameJournal::~FRenameJournal()
+{
+	delete File;
+}
+
+FString FRenameJournal::GetJournalPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("LeartesRenameTool") / TEXT("RenameJournal.txt");
+}
+
+bool FRenameJournal::Begin(TConstArrayView<FAssetRenameData> Plan)
+{
+	const FString Path = GetJournalPath();
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+
+	delete File;
+	File = PlatformFile.OpenWrite(*Path);
+	if (!File)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not create rename journal '%s', the batch runs without one"), *Path);
+		return false;
+	}
+
+	// the plan goes out in one write, a journal cut short before the first rename has no complete plan
+	FString Text = FString::Printf(TEXT("%s\t1\t%d\n"), JournalHeader, Plan.Num());
+	for (const FAssetRenameData& Data : Plan)
+	{
+		const UObject* Asset = Data.Asset.Get();
+		Text += FString::Printf(TEXT("P\t%s\t%s\t%s\n"), Asset ? *Asset->GetPathName() : TEXT(""), *Data.NewPackagePath, *Data.NewName);
+	}
+	Write(Text);
+	return true;
+}
+
+void FRenameJournal::Finish()
+{
+	if (!File) return;
+
+	delete File;
+	File = nullptr;
+	Discard();
+}
+
+void FRenameJournal::Write(const FString& Text)
+{
+	const FTCHARToUTF8 Utf8(*Text);
+	if (!File->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Writing the rename journal failed, the batch continues without it"));
+		delete File;
+		File = nullptr;
+		return;
+	}
+	// flushed to disk, not just to the os, so a power loss keeps what was written
+	File->Flush(true);
+}
+
+bool FRenameJournal::HasPendingJournal()
+{
+	return IFileManager::Get().FileExists(*GetJournalPath());
+}
+
+TArray<FRenameJournal::FEntry> FRenameJournal::ReadPendingJournal()
+{
+	TArray<FEntry> Entries;
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetJournalPath()) || Lines.Num() == 0)
+	{
+		return Entries;
+	}
+
+	TArray<FString> Fields;
+	Lines[0].ParseIntoArray(Fields, TEXT("\t"), false);
+	int32 NumPlanned = 0;
+	if (Fields.Num() != 3 || Fields[0] != JournalHeader || Fields[1] != TEXT("1") || !LexTryParseString(NumPlanned, *Fields[2]))
+	{
+		return Entries;
+	}
+
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		// a line the crash cut short does not parse and is dropped
+		Lines[LineIndex].ParseIntoArray(Fields, TEXT("\t"), false);
+		if (Fields.Num() == 4 && Fields[0] == TEXT("P"))
+		{
+			Entries.Add({ MoveTemp(Fields[1]), MoveTemp(Fields[2]), MoveTemp(Fields[3]) });
+		}
+	}
+
+	// nothing was renamed before the plan was complete on disk
+	if (Entries.Num() != NumPlanned)
+	{
+		Entries.Reset();
+		return Entries;
+	}
+
+	// renames that only happened in memory died with the process, what counts is what was saved
+	// the registry may not have gathered the files of this session yet, so the ones that matter are scanned now
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FString> OldPackageFiles;
+	for (FEntry& Entry : Entries)
+	{
+		FString OldFilename;
+		if (!FPackageName::DoesPackageExist(Entry.NewPackagePath / Entry.NewName))
+		{
+			Entry.State = EState::Pending;
+		}
+		else if (FPackageName::DoesPackageExist(FPackageName::ObjectPathToPackageName(Entry.OldObjectPath), &OldFilename))
+		{
+			Entry.State = EState::Duplicated;
+			OldPackageFiles.Add(MoveTemp(OldFilename));
+		}
+		else
+		{
+			Entry.State = EState::Done;
+		}
+	}
+
+	if (OldPackageFiles.Num() > 0)
+	{
+		AssetRegistry.ScanFilesSynchronous(OldPackageFiles, true);
+		for (FEntry& Entry : Entries)
+		{
+			if (Entry.State != EState::Duplicated) continue;
+
+			const FAssetData OldAsset = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Entry.OldObjectPath), true);
+			if (!OldAsset.IsValid() || OldAsset.IsRedirector())
+			{
+				Entry.State = EState::Done;
+			}
+		}
+	}
+	return Entries;
+}
+
+// the batch died between saving an item's new package and its old one, the new package is a copy of the asset the
+// old one still holds, deleting the copy takes the item back to not renamed
+static bool DeleteDuplicate(const FRenameJournal::FEntry& Entry, TArray<FString>& OutDeletedFiles)
+{
+	FString Filename;
+	if (!FPackageName::DoesPackageExist(Entry.NewPackagePath / Entry.NewName, &Filename))
+	{
+		return true;
+	}
+	if (!IFileManager::Get().Delete(*Filename, false, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Could not delete '%s', a copy of '%s' left by the unfinished rename"), *Filename, *Entry.OldObjectPath);
+		return false;
+	}
+	OutDeletedFiles.Add(MoveTemp(Filename));
+	return true;
+}
+
+// let the registry drop the deleted copies, AssetTools refuses to rename onto a package it still knows
+static void ForgetDeletedFiles(const TArray<FString>& DeletedFiles)
+{
+	if (DeletedFiles.Num() == 0) return;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.ScanModifiedAssetFiles(DeletedFiles);
+}
+
+FRenameBatchResult FRenameJournal::Resume()
+{
+	FRenameBatchResult Result;
+	FRenameDirtyPackages DirtyPackages;
+	DirtyPackages.Begin();
+
+	TArray<FEntry> Entries = ReadPendingJournal();
+
+	TArray<FString> DeletedFiles;
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.State == EState::Duplicated && DeleteDuplicate(Entry, DeletedFiles))
+		{
+			Entry.State = EState::Pending;
+		}
+	}
+	ForgetDeletedFiles(DeletedFiles);
+
+	TArray<FAssetRenameData> RenameData;
+	TArray<int32> RenamedItems;
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.State == EState::Done) continue;
+
+		FRenameItemResult& Item = Result.Items.AddDefaulted_GetRef();
+		Item.OldName = Entry.OldObjectPath;
+		Item.NewName = Entry.NewPackagePath / Entry.NewName;
+
+		// a copy that could not be deleted blocks the rename
+		UObject* Asset = Entry.State == EState::Pending ? FSoftObjectPath(Entry.OldObjectPath).TryLoad() : nullptr;
+		if (Asset)
+		{
+			RenameData.Emplace(Asset, Entry.NewPackagePath, Entry.NewName);
+			RenamedItems.Add(Result.Items.Num() - 1);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Resume: could not rename '%s'"), *Entry.OldObjectPath);
+			Result.FailureCount++;
+		}
+	}
+
+	if (RenameData.Num() > 0)
+	{
+		IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+		AssetTools.RenameAssets(RenameData);
+	}
+
+	for (int32 ItemIndex : RenamedItems)
+	{
+		FRenameItemResult& Item = Result.Items[ItemIndex];
+		const UObject* Asset = FSoftObjectPath(Item.NewName + TEXT(".") + FPackageName::GetShortName(Item.NewName)).ResolveObject();
+		Item.bSuccess = Asset && !Asset->IsA<UObjectRedirector>();
+		Item.bSuccess ? ++Result.SuccessCount : ++Result.FailureCount;
+		if (Item.bSuccess)
+		{
+			DirtyPackages.Add(Asset->GetPackage(), true);
+			DirtyPackages.Add(FindPackage(nullptr, *FPackageName::ObjectPathToPackageName(Item.OldName)));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Resumed rename journal. Success: %d, Failed: %d"), Result.SuccessCount, Result.FailureCount);
+	SaveRecovery(DirtyPackages, Result);
+	return Result;
+}
+
+FRenameBatchResult FRenameJournal::Rollback()
+{
+	FRenameBatchResult Result;
+	FRenameDirtyPackages DirtyPackages;
+	DirtyPackages.Begin();
+
+	TArray<FAssetRenameData> RenameData;
+	TArray<int32> RenamedItems;
+	TArray<FString> DeletedFiles;
+	for (const FEntry& Entry : ReadPendingJournal())
+	{
+		if (Entry.State == EState::Pending) continue;
+
+		// old object paths are /Path/Package.Asset
+		const FString NewObjectPath = Entry.NewPackagePath / Entry.NewName + TEXT(".") + Entry.NewName;
+		FString OldPackage;
+		FString OldAssetName;
+		Entry.OldObjectPath.Split(TEXT("."), &OldPackage, &OldAssetName);
+
+		FRenameItemResult& Item = Result.Items.AddDefaulted_GetRef();
+		Item.OldName = NewObjectPath;
+		Item.NewName = Entry.OldObjectPath;
+
+		// the old package still holds the asset, only the copy has to go
+		if (Entry.State == EState::Duplicated)
+		{
+			Item.bSuccess = DeleteDuplicate(Entry, DeletedFiles);
+			Item.bSuccess ? ++Result.SuccessCount : ++Result.FailureCount;
+			continue;
+		}
+
+		if (UObject* Asset = FSoftObjectPath(NewObjectPath).TryLoad())
+		{
+			RenameData.Emplace(Asset, FPackageName::GetLongPackagePath(OldPackage), OldAssetName);
+			RenamedItems.Add(Result.Items.Num() - 1);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Rollback: could not load '%s'"), *NewObjectPath);
+			Result.FailureCount++;
+		}
+	}
+	ForgetDeletedFiles(DeletedFiles);
+
+	if (RenameData.Num() > 0)
+	{
+		IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+		AssetTools.RenameAssets(RenameData);
+	}
+
+	// the old path held a redirector since the rename, only the asset itself there means it moved back
+	for (int32 ItemIndex : RenamedItems)
+	{
+		FRenameItemResult& Item = Result.Items[ItemIndex];
+		const UObject* Asset = FSoftObjectPath(Item.NewName).ResolveObject();
+		Item.bSuccess = Asset && !Asset->IsA<UObjectRedirector>();
+		Item.bSuccess ? ++Result.SuccessCount : ++Result.FailureCount;
+		if (Item.bSuccess)
+		{
+			DirtyPackages.Add(Asset->GetPackage(), true);
+			DirtyPackages.Add(FindPackage(nullptr, *FPackageName::ObjectPathToPackageName(Item.OldName)));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Rolled back rename journal. Success: %d, Failed: %d"), Result.SuccessCount, Result.FailureCount);
+	SaveRecovery(DirtyPackages, Result);
+	return Result;
+}
+
+void FRenameJournal::SaveRecovery(FRenameDirtyPackages& DirtyPackages, FRenameBatchResult& Result)
+{
+	DirtyPackages.Save(Result);
+	if (Result.SaveFailures.Num() == 0)
+	{
+		Discard();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Keeping the rename journal, %d package(s) could not be saved"), Result.SaveFailures.Num());
+	}
+}
+
+void FRenameJournal::Discard()
+{
+	IFileManager::Get().Delete(*GetJournalPath(), false, true, true);
+}
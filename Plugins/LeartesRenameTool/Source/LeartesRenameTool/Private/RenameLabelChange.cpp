@@ -0,0 +1,61 @@
+#include "RenameLabelChange.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+void FRenameLabelChange::Reserve(int32 NumActors, int32 NumChars)
+{
+	Entries.Reserve(NumActors);
+	Labels.Reserve(NumChars);
+}
+
+void FRenameLabelChange::Add(AActor* Actor, FStringView OldLabel, FStringView NewLabel, FName OldName, FName NewName)
+{
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Actor = Actor;
+	Entry.OldName = OldName;
+	Entry.NewName = NewName;
+	Entry.OldStart = Labels.Num();
+	Entry.OldLen = OldLabel.Len();
+	Labels.Append(OldLabel.GetData(), OldLabel.Len());
+	Entry.NewStart = Labels.Num();
+	Entry.NewLen = NewLabel.Len();
+	Labels.Append(NewLabel.GetData(), NewLabel.Len());
+}
+
+void FRenameLabelChange::Apply(UObject* Object)
+{
+	SetLabels(true);
+}
+
+void FRenameLabelChange::Revert(UObject* Object)
+{
+	SetLabels(false);
+}
+
+FString FRenameLabelChange::ToString() const
+{
+	return FString::Printf(TEXT("Rename Actors (%d)"), Entries.Num());
+}
+
+//actors deleted since the rename are skipped, the label index follows through the label changed event
+//the label goes first, SetActorLabel may pick an object name of its own, the recorded one is put back after it
+//a name another object took in the meantime is left alone, the label is still restored
+void FRenameLabelChange::SetLabels(bool bNew) const
+{
+	FString Label;
+	for (const FEntry& Entry : Entries)
+	{
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor) continue;
+
+		Label.Reset();
+		Label.AppendChars(Labels.GetData() + (bNew ? Entry.NewStart : Entry.OldStart), bNew ? Entry.NewLen : Entry.OldLen);
+		Actor->SetActorLabel(Label, true);
+
+		const FName Name = bNew ? Entry.NewName : Entry.OldName;
+		if (Actor->GetFName() != Name && !StaticFindObjectFast(nullptr, Actor->GetOuter(), Name))
+		{
+			Actor->Rename(FNameBuilder(Name).ToString(), nullptr, REN_DontCreateRedirectors | REN_NonTransactional | REN_ForceNoResetLoaders);
+		}
+	}
+}
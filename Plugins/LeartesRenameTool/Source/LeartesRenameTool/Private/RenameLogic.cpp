@@ -16,221 +16,758 @@
 #include "UObject/UObjectGlobals.h"
 #include "Engine/World.h"
 #include "Subsystems/AssetEditorSubsystem.h"
+#include "Containers/Ticker.h"
+#include "ActorLabelIndex.h"
+#include "AssetNameIndex.h"
+#include "RenameNamePlan.h"
+#include "RenameLabelChange.h"
+#include "RenameJournal.h"
+#include "RenameDirtyPackages.h"
+#include "Misc/ITransaction.h"
+#include "Async/ParallelFor.h"
+#include "UObject/ObjectRedirector.h"
+#include "UObject/UObjectHash.h"
 
-// apply case transformation according to ECaseOp
-static FString ApplyCaseOp(const FString& In, ECaseOp Op)
+//build new name from old name using options and index for numbering
+//batch callers compile an FRenameNamePlan once instead of going through this per name
+FString FRenameLogic::GenerateNewName(const FString& OldName, const FRenameOptions& Options, int32 Index)
+{
+    return FRenameNamePlan(Options).Generate(OldName, Index);
+}
+
+// map key funcs hashing names through views into the planned name array, so no key is copied
+template<ESearchCase::Type SearchCase>
+struct TNameViewKeyFuncs : TDefaultMapKeyFuncs<FStringView, int32, false>
+{
+    static FORCEINLINE bool Matches(FStringView A, FStringView B) { return A.Equals(B, SearchCase); }
+    static FORCEINLINE uint32 GetKeyHash(FStringView Key) { return GetRenameNameHash(Key, SearchCase); }
+};
+
+// flag new names wanted by more than one item of the same scope (package path or world)
+// when resolving, the first item keeps the name and later ones get the smallest free _N suffix
+// a per name suffix cursor keeps this linear, IsTaken rejects candidates already used outside the batch
+// NumPlanned counts the items of a scope planning a name, the names given out here are tracked on top of it
+// map keys view the first item's string, which is never rewritten, or a candidate whose buffer moves into Names
+template<ESearchCase::Type SearchCase>
+static void ResolveCountedDuplicates(TArray<FString>& Names, const TArray<int32>& Scopes, bool bResolve, TFunctionRef<int32(int32, FStringView)> NumPlanned,
+    TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates)
 {
-    switch (Op)
+    using FNameCounts = TMap<FStringView, int32, FDefaultSetAllocator, TNameViewKeyFuncs<SearchCase>>;
+
+    OutDuplicates.Init(false, Names.Num());
+    bool bAnyDuplicate = false;
+    for (int32 i = 0; i < Names.Num(); ++i)
     {
-    case ECaseOp::Upper:
-        return In.ToUpper();
-    case ECaseOp::Lower:
-        return In.ToLower();
-    case ECaseOp::CapitalizeFirst:
-        if (In.Len() == 0) return In;
+        if (Scopes[i] == INDEX_NONE) continue;
+        if (NumPlanned(Scopes[i], Names[i]) > 1)
+        {
+            OutDuplicates[i] = true;
+            bAnyDuplicate = true;
+        }
+    }
+
+    if (!bResolve || !bAnyDuplicate) return;
+
+    // next suffix to try for each duplicated name, absent until its first item was seen, and the candidates taken so far
+    TMap<int32, FNameCounts> NextSuffixes;
+    TMap<int32, FNameCounts> Resolved;
+    for (int32 i = 0; i < Names.Num(); ++i)
+    {
+        if (!OutDuplicates[i]) continue;
+        OutDuplicates[i] = false;
+
+        FNameCounts& Suffixes = NextSuffixes.FindOrAdd(Scopes[i]);
+        int32* NextSuffix = Suffixes.Find(Names[i]);
+        if (!NextSuffix)
+        {
+            Suffixes.Add(Names[i], 1);
+            continue;
+        }
+
+        FNameCounts& Used = Resolved.FindOrAdd(Scopes[i]);
+        FString Candidate;
+        do
         {
-            FString Out = In;
-            Out[0] = FChar::ToUpper(Out[0]);
-            return Out;
+            Candidate = FString::Printf(TEXT("%s_%d"), *Names[i], (*NextSuffix)++);
         }
-    default:
-        return In;
+        while (NumPlanned(Scopes[i], Candidate) > 0 || Used.Contains(Candidate) || IsTaken(i, Candidate));
+
+        Names[i] = MoveTemp(Candidate);
+        Used.Add(Names[i], 1);
     }
 }
 
-//build new name from old name using options and index for numbering
-FString FRenameLogic::GenerateNewName(const FString& OldName, const FRenameOptions& Options, int32 Index)
+// counts of one batch only live for the call, so they view the names instead of copying them
+template<ESearchCase::Type SearchCase>
+static void ResolveBatchDuplicatesImpl(TArray<FString>& Names, const TArray<int32>& Scopes, bool bResolve, TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates)
 {
-    FString Base = OldName;
+    using FNameCounts = TMap<FStringView, int32, FDefaultSetAllocator, TNameViewKeyFuncs<SearchCase>>;
+
+    TMap<int32, FNameCounts> ScopeCounts;
+    for (int32 i = 0; i < Names.Num(); ++i)
+    {
+        if (Scopes[i] == INDEX_NONE) continue;
+        ScopeCounts.FindOrAdd(Scopes[i]).FindOrAdd(Names[i])++;
+    }
+
+    ResolveCountedDuplicates<SearchCase>(Names, Scopes, bResolve,
+        [&ScopeCounts](int32 Scope, FStringView Name)
+        {
+            const int32* Count = ScopeCounts.FindChecked(Scope).Find(Name);
+            return Count ? *Count : 0;
+        },
+        IsTaken, OutDuplicates);
+}
+
+void FRenameLogic::ResolveBatchDuplicates(TArray<FString>& Names, const TArray<int32>& Scopes, ESearchCase::Type SearchCase, bool bResolve,
+    TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates)
+{
+    if (SearchCase == ESearchCase::CaseSensitive)
+    {
+        ResolveBatchDuplicatesImpl<ESearchCase::CaseSensitive>(Names, Scopes, bResolve, IsTaken, OutDuplicates);
+    }
+    else
+    {
+        ResolveBatchDuplicatesImpl<ESearchCase::IgnoreCase>(Names, Scopes, bResolve, IsTaken, OutDuplicates);
+    }
+}
 
-    //apply find/replace
-    if (!Options.Find.IsEmpty())
+void FRenameLogic::ResolveBatchDuplicates(TArray<FString>& Names, const TArray<int32>& Scopes, const FRenameNameCounts& Counts, bool bResolve,
+    TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates)
+{
+    auto NumPlanned = [&Counts](int32 Scope, FStringView Name) { return Counts.Num(Scope, Name); };
+    if (Counts.GetSearchCase() == ESearchCase::CaseSensitive)
+    {
+        ResolveCountedDuplicates<ESearchCase::CaseSensitive>(Names, Scopes, bResolve, NumPlanned, IsTaken, OutDuplicates);
+    }
+    else
     {
-        Base = Base.Replace(*Options.Find, *Options.Replace, ESearchCase::CaseSensitive);
+        ResolveCountedDuplicates<ESearchCase::IgnoreCase>(Names, Scopes, bResolve, NumPlanned, IsTaken, OutDuplicates);
     }
+}
 
-    // apply case operation
-    Base = ApplyCaseOp(Base, Options.CaseOp);
+// items per task when preview work is split across the task graph
+static constexpr int32 PreviewChunkSize = 2048;
 
-    //prepare numbering portion if requested
-    FString NumberPart;
-    if (Options.bUseNumbering)
+// run Body over [0, Num) in chunks on the task graph, or inline for small batches and when parallel preview is off
+// items never depend on each other, numbering only uses the item index, so results match the serial order
+static void ForEachPreviewChunk(int32 Num, bool bParallel, TFunctionRef<void(int32, int32)> Body)
+{
+    const int32 NumChunks = FMath::DivideAndRoundUp(Num, PreviewChunkSize);
+    if (!bParallel || NumChunks <= 1)
     {
-        int32 Number = Options.StartNumber + Index;
-        NumberPart = FString::Printf(TEXT("%0*d"), FMath::Max(1, Options.Padding), Number);
-        NumberPart = TEXT("_") + NumberPart;
+        Body(0, Num);
+        return;
     }
 
-    //final new name
-    FString NewName = Options.Prefix + Base + NumberPart + Options.Suffix;
-    return NewName;
+    ParallelFor(NumChunks, [Num, &Body](int32 Chunk)
+    {
+        const int32 Begin = Chunk * PreviewChunkSize;
+        Body(Begin, FMath::Min(Begin + PreviewChunkSize, Num));
+    });
 }
 
-// Generate preview list for assets
-TArray<FRenamePreviewItem> FRenameLogic::GeneratePreviewForAssets(const TArray<FAssetData>& Assets, const FRenameOptions& Options)
+// remove the rows of skipped items from a preallocated row array, keeping the order
+static void CompactPreviewRows(TArray<FRenamePreviewItem>& Rows, TFunctionRef<bool(int32)> IsValidItem)
 {
-    TArray<FRenamePreviewItem> Out;
-    Out.Reserve(Assets.Num());
+    int32 WriteIndex = 0;
+    for (int32 i = 0; i < Rows.Num(); ++i)
+    {
+        if (!IsValidItem(i)) continue;
+        if (WriteIndex != i)
+        {
+            Rows[WriteIndex] = MoveTemp(Rows[i]);
+        }
+        WriteIndex++;
+    }
+    Rows.SetNum(WriteIndex);
+}
 
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+TArray<FString> FRenameLogic::PlanAssetNames(const TArray<FAssetData>& Assets, const FRenameOptions& Options, TBitArray<>& OutDuplicates)
+{
+    TArray<FString> Names;
+    TArray<int32> Scopes;
+    Names.SetNum(Assets.Num());
+    Scopes.Init(INDEX_NONE, Assets.Num());
 
+    // assets can only collide with each other inside the same package path
+    TMap<FName, int32> PathScopes;
     for (int32 i = 0; i < Assets.Num(); ++i)
     {
         const FAssetData& AD = Assets[i];
         if (!AD.IsValid()) continue;
 
-        FString OldName = AD.AssetName.ToString();
-        FString NewName = GenerateNewName(OldName, Options, i);
+        Scopes[i] = PathScopes.FindOrAdd(AD.PackagePath, PathScopes.Num());
+    }
 
-        FString PackagePath = AD.PackagePath.ToString();
-        FString NewPackageName = FString::Printf(TEXT("%s/%s"), *PackagePath, *NewName);
+    const FRenameNamePlan Plan(Options);
+    ForEachPreviewChunk(Assets.Num(), Options.bParallelPreview, [&Assets, &Scopes, &Plan, &Names](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            if (Scopes[i] == INDEX_NONE) continue;
 
-        // collision check with asset registry
-        TArray<FAssetData> ExistingAssets;
-        AssetRegistry.GetAssetsByPackageName(*NewPackageName, ExistingAssets);
-        bool bCollision = ExistingAssets.Num() > 0;
+            // the old name only lives on the stack, the new name is allocated once at its final size
+            Plan.Generate(FNameBuilder(Assets[i].AssetName).ToView(), i, Names[i]);
+        }
+    });
 
-        Out.Add(FRenamePreviewItem(OldName, NewName, bCollision));
+    // snapshot every target path up front so all later lookups are read only
+    FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+    for (const TPair<FName, int32>& PathScope : PathScopes)
+    {
+        NameIndex.EnsurePath(PathScope.Key);
     }
 
+    ResolveBatchDuplicates(Names, Scopes, ESearchCase::IgnoreCase, Options.bResolveDuplicates,
+        [&Assets, &NameIndex](int32 Item, const FString& Candidate) { return NameIndex.DoesPackageExist(Assets[Item].PackagePath, Candidate); },
+        OutDuplicates);
+
+    return Names;
+}
+
+// plan actor labels and hand back the old labels and worlds read on the calling thread, so later worker
+// chunks never call into the actors
+static TArray<FString> PlanActorNamesImpl(const TArray<AActor*>& Actors, const FRenameOptions& Options, TBitArray<>& OutDuplicates,
+    TArray<const FString*>& Labels, TArray<UWorld*>& Worlds)
+{
+    TArray<FString> Names;
+    TArray<int32> Scopes;
+    Names.SetNum(Actors.Num());
+    Scopes.Init(INDEX_NONE, Actors.Num());
+    Labels.Init(nullptr, Actors.Num());
+    Worlds.Init(nullptr, Actors.Num());
+
+    // labels are read on the calling thread because GetActorLabel may create a default one
+    // labels only need to be unique within a world
+    TMap<UWorld*, int32> WorldScopes;
+    for (int32 i = 0; i < Actors.Num(); ++i)
+    {
+        AActor* Actor = Actors[i];
+        if (!Actor) continue;
+
+        Labels[i] = &Actor->GetActorLabel();
+        Worlds[i] = Actor->GetWorld();
+        Scopes[i] = WorldScopes.FindOrAdd(Worlds[i], WorldScopes.Num());
+    }
+
+    const FRenameNamePlan Plan(Options);
+    ForEachPreviewChunk(Actors.Num(), Options.bParallelPreview, [&Labels, &Plan, &Names](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            if (!Labels[i]) continue;
+            Plan.Generate(*Labels[i], i, Names[i]);
+        }
+    });
+
+    // index every involved world up front so all later lookups are read only
+    FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+    for (const TPair<UWorld*, int32>& WorldScope : WorldScopes)
+    {
+        LabelIndex.EnsureWorld(WorldScope.Key);
+    }
+
+    FRenameLogic::ResolveBatchDuplicates(Names, Scopes, ESearchCase::CaseSensitive, Options.bResolveDuplicates,
+        [&Actors, &Worlds, &LabelIndex](int32 Item, const FString& Candidate) { return LabelIndex.IsLabelUsed(Worlds[Item], Candidate, Actors[Item]); },
+        OutDuplicates);
+
+    return Names;
+}
+
+TArray<FString> FRenameLogic::PlanActorNames(const TArray<AActor*>& Actors, const FRenameOptions& Options, TBitArray<>& OutDuplicates)
+{
+    TArray<const FString*> Labels;
+    TArray<UWorld*> Worlds;
+    return PlanActorNamesImpl(Actors, Options, OutDuplicates, Labels, Worlds);
+}
+
+// Generate preview list for assets
+TArray<FRenamePreviewItem> FRenameLogic::GeneratePreviewForAssets(const TArray<FAssetData>& Assets, const FRenameOptions& Options)
+{
+    TBitArray<> Duplicates;
+    TArray<FString> NewNames = PlanAssetNames(Assets, Options, Duplicates);
+
+    // package names are looked up in a shared snapshot instead of querying the registry per row
+    // the plan already snapshotted every target path, so chunks only read the index
+    FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+
+    // rows are written in place by index, skipped items are compacted away afterwards
+    TArray<FRenamePreviewItem> Out;
+    Out.SetNum(Assets.Num());
+
+    ForEachPreviewChunk(Assets.Num(), Options.bParallelPreview, [&Assets, &NameIndex, &NewNames, &Duplicates, &Out](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            const FAssetData& AD = Assets[i];
+            if (!AD.IsValid()) continue;
+
+            // collision check against the packages already in the target path
+            bool bCollision = NameIndex.DoesPackageExist(AD.PackagePath, NewNames[i]);
+
+            // the planned name moves into the row, only the displayed old name is allocated here, at its final size
+            Out[i] = FRenamePreviewItem(FString(FNameBuilder(AD.AssetName).ToView()), MoveTemp(NewNames[i]), bCollision);
+            Out[i].bBatchDuplicate = Duplicates[i];
+        }
+    });
+
+    CompactPreviewRows(Out, [&Assets](int32 i) { return Assets[i].IsValid(); });
     return Out;
 }
 
 //generate actor rename preview using actor labels
 TArray<FRenamePreviewItem> FRenameLogic::GeneratePreviewForActors(const TArray<AActor*>& Actors, const FRenameOptions& Options)
 {
+    TBitArray<> Duplicates;
+    TArray<const FString*> Labels;
+    TArray<UWorld*> Worlds;
+    TArray<FString> NewNames = PlanActorNamesImpl(Actors, Options, Duplicates, Labels, Worlds);
+
+    // hashed label lookups instead of walking every actor of the world per item
+    // the plan already indexed every involved world and read every label and world, so chunks only read those
+    // and the index, through its thread safe key overload
+    const FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+
     TArray<FRenamePreviewItem> Out;
-    Out.Reserve(Actors.Num());
+    Out.SetNum(Actors.Num());
 
-    for (int32 i = 0; i < Actors.Num(); ++i)
+    ForEachPreviewChunk(Actors.Num(), Options.bParallelPreview, [&Actors, &Labels, &Worlds, &LabelIndex, &NewNames, &Duplicates, &Out](int32 Begin, int32 End)
     {
-        AActor* Actor = Actors[i];
-        if (!Actor) continue;
+        for (int32 i = Begin; i < End; ++i)
+        {
+            if (!Labels[i]) continue;
+
+            bool bCollision = LabelIndex.IsLabelUsed(TObjectKey<UWorld>(Worlds[i]), NewNames[i], TObjectKey<AActor>(Actors[i]));
+
+            Out[i] = FRenamePreviewItem(*Labels[i], MoveTemp(NewNames[i]), bCollision);
+            Out[i].bBatchDuplicate = Duplicates[i];
+        }
+    });
+
+    CompactPreviewRows(Out, [&Actors](int32 i) { return Actors[i] != nullptr; });
+    return Out;
+}
+
+// check whether AssetTools actually moved the asset to its planned package
+static bool WasAssetRenamed(const FAssetRenameData& RenameData)
+{
+    const UObject* Asset = RenameData.Asset.Get();
+    if (!Asset)
+    {
+        return false;
+    }
+
+    const FString ExpectedPackageName = RenameData.NewPackagePath / RenameData.NewName;
+    return Asset->GetPackage()->GetName().Equals(ExpectedPackageName, ESearchCase::IgnoreCase);
+}
+
+// files waiting for a deferred registry rescan, drained a few per tick
+static TArray<FString> PendingRegistryFiles;
+static FTSTicker::FDelegateHandle RegistryUpdateTickerHandle;
+static constexpr int32 RegistryFilesPerTick = 64;
+
+static bool TickDeferredRegistryUpdate(float DeltaTime)
+{
+    const int32 Count = FMath::Min(RegistryFilesPerTick, PendingRegistryFiles.Num());
+    if (Count > 0)
+    {
+        TArray<FString> Files(PendingRegistryFiles.GetData(), Count);
+        PendingRegistryFiles.RemoveAt(0, Count, EAllowShrinking::No);
+
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        AssetRegistry.ScanFilesSynchronous(Files, true);
+    }
+
+    if (PendingRegistryFiles.Num() == 0)
+    {
+        PendingRegistryFiles.Empty();
+        RegistryUpdateTickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
 
-        FString OldName = Actor->GetActorLabel();
-        FString NewName = GenerateNewName(OldName, Options, i);
+// rescan only the on-disk files of the packages touched by a rename batch
+// packages that only exist in memory are already tracked by the registry through AssetTools
+static void UpdateRegistryForPackages(const TArray<FString>& PackageNames, bool bDeferred)
+{
+    TArray<FString> Files;
+    Files.Reserve(PackageNames.Num());
 
-        bool bCollision = false;
-        UWorld* World = Actor->GetWorld();
-        if (World)
+    for (const FString& PackageName : PackageNames)
+    {
+        FString Filename;
+        if (FPackageName::DoesPackageExist(PackageName, &Filename))
         {
-            for (TActorIterator<AActor> It(World); It; ++It)
-            {
-                AActor* Other = *It;
-                if (Other && Other != Actor)
-                {
-                    if (Other->GetActorLabel().Equals(NewName, ESearchCase::CaseSensitive))
-                    {
-                        bCollision = true;
-                        break;
-                    }
-                }
-            }
+            Files.Add(MoveTemp(Filename));
         }
+    }
+
+    if (Files.Num() == 0) return;
 
-        Out.Add(FRenamePreviewItem(OldName, NewName, bCollision));
+    UE_LOG(LogTemp, Log, TEXT("Updating asset registry for %d renamed package file(s)%s"), Files.Num(), bDeferred ? TEXT(" in the background") : TEXT(""));
+
+    if (!bDeferred)
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+        AssetRegistry.ScanFilesSynchronous(Files, true);
+        return;
     }
 
-    return Out;
+    PendingRegistryFiles.Append(MoveTemp(Files));
+    if (!RegistryUpdateTickerHandle.IsValid())
+    {
+        RegistryUpdateTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickDeferredRegistryUpdate));
+    }
 }
 
-//rename assets in batch one by one with logging and error handling using AssetTools
-void FRenameLogic::RenameAssetsBatch(const TArray<FAssetData>& AssetsToRename, const FRenameOptions& Options)
+// resolve the referencers of every redirector a batch left behind in one sweep, so a package referencing
+// several renamed assets is loaded and saved once, then delete the redirectors
+static void FixupBatchRedirectors(FRenameBatchResult& Result)
 {
-    if (AssetsToRename.Num() == 0) return;
+    const double Start = FPlatformTime::Seconds();
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
 
-    const FText TransactionText = FText::FromString(TEXT("Rename Assets"));
-    FScopedTransaction Transaction(TransactionText);
+    TArray<UObjectRedirector*> Redirectors;
+    TArray<FName> RedirectorPackageNames;
+    TSet<FName> RedirectorPackages;
+    for (const FRenameItemResult& Item : Result.Items)
+    {
+        if (!Item.bSuccess) continue;
+
+        // the redirector sits in the old package, under the old asset name
+        UPackage* Package = FindPackage(nullptr, *Item.OldName);
+        if (!Package) continue;
+
+        ForEachObjectWithPackage(Package, [&Redirectors, &RedirectorPackageNames, Package](UObject* Object)
+        {
+            if (UObjectRedirector* Redirector = Cast<UObjectRedirector>(Object))
+            {
+                Redirectors.Add(Redirector);
+                RedirectorPackageNames.Add(Package->GetFName());
+            }
+            return true;
+        }, false);
+        RedirectorPackages.Add(Package->GetFName());
+    }
+
+    if (Redirectors.Num() == 0) return;
+
+    // referencers as the registry knows them from disk, the sweep changes them
+    TMap<FName, TArray<FName>> PackageReferencers;
+    for (const FName& PackageName : RedirectorPackages)
+    {
+        TArray<FName>& Referencers = PackageReferencers.Add(PackageName);
+        AssetRegistry.GetReferencers(PackageName, Referencers);
+        Referencers.RemoveAll([&RedirectorPackages](FName Referencer) { return RedirectorPackages.Contains(Referencer); });
+    }
+
+    TArray<TWeakObjectPtr<UObjectRedirector>> WeakRedirectors(Redirectors);
 
     IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
-    FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-    IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+    AssetTools.FixupReferencers(Redirectors, false, ERedirectFixupMode::DeleteFixedUpRedirectors);
+
+    // a redirector is only deleted once all its referencers were saved, so only those count as updated,
+    // each once however many deleted redirectors it used
+    TSet<FName> FixedUp;
+    Result.DeletedRedirectors = 0;
+    for (int32 i = 0; i < WeakRedirectors.Num(); ++i)
+    {
+        if (WeakRedirectors[i].IsValid()) continue;
+
+        Result.DeletedRedirectors++;
+        FixedUp.Append(PackageReferencers.FindChecked(RedirectorPackageNames[i]));
+    }
+    Result.FixedUpPackages = FixedUp.Num();
+    Result.FixupSeconds = FPlatformTime::Seconds() - Start;
 
-    int32 SuccessCount = 0;
-    int32 FailureCount = 0;
+    UE_LOG(LogTemp, Display, TEXT("Redirector fixup: %d referencing package(s) updated, %d of %d redirector(s) deleted in %.2f s"),
+        Result.FixedUpPackages, Result.DeletedRedirectors, Redirectors.Num(), Result.FixupSeconds);
+}
 
-    for (int32 i = 0; i < AssetsToRename.Num(); ++i)
+void FRenameLogic::CancelDeferredRegistryUpdate()
+{
+    if (RegistryUpdateTickerHandle.IsValid())
     {
-        const FAssetData& AD = AssetsToRename[i];
+        FTSTicker::GetCoreTicker().RemoveTicker(RegistryUpdateTickerHandle);
+        RegistryUpdateTickerHandle.Reset();
+    }
+    PendingRegistryFiles.Empty();
+}
+
+//every path is composed on the stack, the only strings allocated per asset are the ones kept: the planned name,
+//which moves into the rename data, the result's old and new package names and the rename data's package path
+void FRenameLogic::PlanAssetRenames(const TArray<FAssetData>& Assets, const FRenameOptions& Options, FRenameBatchResult& Result,
+    TArray<FAssetRenameData>& OutRenameData, TArray<int32>& OutResultIndices)
+{
+    TBitArray<> Duplicates;
+    TArray<FString> NewNames = PlanAssetNames(Assets, Options, Duplicates);
+
+    OutRenameData.Reserve(OutRenameData.Num() + Assets.Num());
+    OutResultIndices.Reserve(OutResultIndices.Num() + Assets.Num());
+    Result.Items.Reserve(Result.Items.Num() + Assets.Num());
+
+    TStringBuilder<256> NewPackageName;
+    for (int32 i = 0; i < Assets.Num(); ++i)
+    {
+        const FAssetData& AD = Assets[i];
+        FRenameItemResult& Item = Result.Items.AddDefaulted_GetRef();
+
         if (!AD.IsValid())
         {
             UE_LOG(LogTemp, Warning, TEXT("Skipping invalid asset data at index %d"), i);
-            FailureCount++;
+            Result.FailureCount++;
+            continue;
+        }
+
+        Item.OldName = FString(FNameBuilder(AD.PackageName).ToView());
+
+        // AssetTools would fail on the second asset moved to the same package, so skip unresolved duplicates
+        if (Duplicates[i])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping asset '%s': another asset in the batch is renamed to '%s'"), *Item.OldName, *NewNames[i]);
+            Result.FailureCount++;
             continue;
         }
 
-        // try to load uobject for the asset
-        UObject* AssetObj = AD.GetAsset();
+        // finds the asset in memory without building its object path, loads it otherwise
+        UObject* AssetObj = AD.FastGetAsset(true);
         if (!AssetObj)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Could not load asset: %s"), *AD.AssetName.ToString());
-            FailureCount++;
+            UE_LOG(LogTemp, Warning, TEXT("Could not load asset: %s"), *Item.OldName);
+            Result.FailureCount++;
             continue;
         }
 
-        FString OldName = AD.AssetName.ToString();
-        FString NewName = GenerateNewName(OldName, Options, i);
-        
-        FString PackagePath = AD.PackagePath.ToString();
-        FString NewPackagePath = FString::Printf(TEXT("%s/%s"), *PackagePath, *NewName);
+        const FNameBuilder PackagePath(AD.PackagePath);
+        NewPackageName.Reset();
+        NewPackageName << PackagePath << TEXT('/') << NewNames[i];
+        Item.NewName = FString(NewPackageName.ToView());
+
+        UE_LOG(LogTemp, Log, TEXT("Planned asset rename: '%s' -> '%s'"), *Item.OldName, *Item.NewName);
 
-        UE_LOG(LogTemp, Log, TEXT("Attempting to rename asset: '%s' -> '%s'"), *AD.PackageName.ToString(), *NewPackagePath);
+        // the constructor copies its strings, so they are assigned after it
+        FAssetRenameData& RenameData = OutRenameData.Emplace_GetRef(AssetObj, FString(), FString());
+        RenameData.NewPackagePath = FString(PackagePath.ToView());
+        RenameData.NewName = MoveTemp(NewNames[i]);
+        OutResultIndices.Add(Result.Items.Num() - 1);
+    }
+}
 
-        //Prepare rename data for a single asset
-        TArray<FAssetRenameData> RenameDataArray;
-        FAssetRenameData RenameData(AssetObj, PackagePath, NewName);
-        RenameDataArray.Add(RenameData);
+//rename assets using AssetTools, either as one bulk submission (in optional chunks) or one call per asset
+FRenameBatchResult FRenameLogic::RenameAssetsBatch(const TArray<FAssetData>& AssetsToRename, const FRenameOptions& Options)
+{
+    FRenameBatchResult Result;
+    if (AssetsToRename.Num() == 0) return Result;
 
-        //returns bool indicating success for the operation
-        bool bRenameSuccess = AssetTools.RenameAssets(RenameDataArray);
-        
-        if (bRenameSuccess)
+    const FText TransactionText = FText::FromString(TEXT("Rename Assets"));
+    TOptional<FScopedTransaction> Transaction;
+    Transaction.Emplace(TransactionText, Options.bTransactional);
+
+    // the redirector fixup writes referencers pointing at the new names, so the renamed packages are saved first
+    const bool bSavePackages = Options.bSaveOnApply || Options.bFixupRedirectors;
+    FRenameDirtyPackages DirtyPackages;
+    if (bSavePackages)
+    {
+        DirtyPackages.Begin();
+    }
+
+    IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+
+    // plan the whole batch first, rename data and result items share the same order
+    TArray<FAssetRenameData> RenameDataArray;
+    TArray<int32> ResultIndices;
+    PlanAssetRenames(AssetsToRename, Options, Result, RenameDataArray, ResultIndices);
+
+    // bulk mode submits the plan in as few calls as possible so referencers are fixed up once per chunk
+    int32 ChunkSize = 1;
+    if (Options.bBulkAssetRename)
+    {
+        ChunkSize = Options.BulkRenameChunkSize > 0 ? Options.BulkRenameChunkSize : FMath::Max(1, RenameDataArray.Num());
+    }
+    const int32 NumChunks = FMath::DivideAndRoundUp(RenameDataArray.Num(), ChunkSize);
+
+    // AssetTools renames in memory only, the disk changes when the packages are saved, so only a batch that
+    // saves keeps a journal, from before the first rename until every package was saved
+    // without saving, a crash before the user saves loses nothing
+    FRenameJournal Journal;
+    if (bSavePackages && RenameDataArray.Num() > 0)
+    {
+        Journal.Begin(RenameDataArray);
+    }
+
+    FScopedSlowTask SlowTask(NumChunks, FText::FromString(TEXT("Renaming assets...")));
+    SlowTask.MakeDialogDelayed(1.0f);
+
+    for (int32 ChunkStart = 0; ChunkStart < RenameDataArray.Num(); ChunkStart += ChunkSize)
+    {
+        SlowTask.EnterProgressFrame(1);
+
+        // the plan is not needed past its chunk, so the entries move instead of copying their strings
+        const int32 ChunkCount = FMath::Min(ChunkSize, RenameDataArray.Num() - ChunkStart);
+        TArray<FAssetRenameData> ChunkData;
+        ChunkData.Reserve(ChunkCount);
+        for (int32 j = 0; j < ChunkCount; ++j)
         {
-            UE_LOG(LogTemp, Log, TEXT("Successfully renamed asset: '%s' to '%s'"), *OldName, *NewName);
-            SuccessCount++;
+            ChunkData.Add(MoveTemp(RenameDataArray[ChunkStart + j]));
         }
-        else
+
+        //the returned bool covers the whole chunk, so verify every asset afterwards
+        AssetTools.RenameAssets(ChunkData);
+
+        for (int32 j = 0; j < ChunkCount; ++j)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to rename asset: '%s' to '%s'"), *OldName, *NewName);
-            FailureCount++;
+            FRenameItemResult& Item = Result.Items[ResultIndices[ChunkStart + j]];
+            Item.bSuccess = WasAssetRenamed(ChunkData[j]);
+
+            if (Item.bSuccess)
+            {
+                UE_LOG(LogTemp, Log, TEXT("Successfully renamed asset: '%s' to '%s'"), *Item.OldName, *Item.NewName);
+                Result.SuccessCount++;
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to rename asset: '%s' to '%s'"), *Item.OldName, *Item.NewName);
+                Result.FailureCount++;
+            }
         }
     }
 
-    // update asset registry if any assets were successfully renamed
-    if (SuccessCount > 0)
+    // update asset registry for the packages this batch touched instead of rescanning the project
+    if (Result.SuccessCount > 0)
     {
-        TArray<FString> PathsToScan;
-        PathsToScan.Add(TEXT("/Game"));
-        AssetRegistry.ScanPathsSynchronous(PathsToScan, true);
+        TArray<FString> TouchedPackages;
+        TouchedPackages.Reserve(Result.SuccessCount * 2);
+        for (const FRenameItemResult& Item : Result.Items)
+        {
+            if (Item.bSuccess)
+            {
+                TouchedPackages.Add(Item.OldName);
+                TouchedPackages.Add(Item.NewName);
+            }
+        }
+        UpdateRegistryForPackages(TouchedPackages, Options.bDeferRegistryUpdate);
+
+        // saving and deleting redirectors cannot be undone, so they are not part of the undoable rename
+        Transaction.Reset();
+
+        if (bSavePackages)
+        {
+            for (const FRenameItemResult& Item : Result.Items)
+            {
+                if (Item.bSuccess)
+                {
+                    // the asset under its new name, and the redirector left in the old package, which only
+                    // goes to disk once every new package is there, see FRenameJournal
+                    DirtyPackages.Add(FindPackage(nullptr, *Item.NewName), true);
+                    DirtyPackages.Add(FindPackage(nullptr, *Item.OldName));
+                }
+            }
+            DirtyPackages.Save(Result);
+        }
+
+        // referencers must not point at assets that are not on disk
+        if (Options.bFixupRedirectors && Result.SaveFailures.Num() == 0)
+        {
+            FixupBatchRedirectors(Result);
+        }
+        else if (Options.bFixupRedirectors)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Skipping the redirector fixup, %d package(s) of the rename could not be saved"), Result.SaveFailures.Num());
+        }
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Asset rename batch completed. Success: %d, Failed: %d"), SuccessCount, FailureCount);
+    // a package that could not be saved leaves the disk half renamed, the journal stays for the next start
+    if (Result.SaveFailures.Num() == 0)
+    {
+        Journal.Finish();
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Keeping the rename journal, %d package(s) could not be saved"), Result.SaveFailures.Num());
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Asset rename batch completed in %d call(s). Success: %d, Failed: %d"), NumChunks, Result.SuccessCount, Result.FailureCount);
+    return Result;
 }
 
 //Rename actors in world by setting actor labels
-void FRenameLogic::RenameActorsBatch(const TArray<AActor*>& ActorsToRename, const FRenameOptions& Options)
+FRenameBatchResult FRenameLogic::RenameActorsBatch(const TArray<AActor*>& ActorsToRename, const FRenameOptions& Options)
 {
-    if (ActorsToRename.Num() == 0) return;
+    FRenameBatchResult Result;
+    if (ActorsToRename.Num() == 0) return Result;
 
     const FText TransactionText = FText::FromString(TEXT("Rename Actors"));
-    FScopedTransaction Transaction(TransactionText);
+    TOptional<FScopedTransaction> Transaction;
+    Transaction.Emplace(TransactionText, Options.bTransactional);
+
+    FRenameDirtyPackages DirtyPackages;
+    if (Options.bSaveOnApply)
+    {
+        DirtyPackages.Begin();
+    }
 
-    int32 SuccessCount = 0;
+    Result.Items.Reserve(ActorsToRename.Num());
+
+    // duplicate labels are legal, so unresolved batch duplicates are still applied
+    TBitArray<> Duplicates;
+    TArray<FString> NewLabels = PlanActorNames(ActorsToRename, Options, Duplicates);
+
+    // undo keeps only the labels and object names, SetActorLabel would otherwise snapshot every actor into the transaction
+    TUniquePtr<FRenameLabelChange> LabelChange;
+    UWorld* ChangeWorld = nullptr;
+    if (GUndo && Options.bTransactional)
+    {
+        LabelChange = MakeUnique<FRenameLabelChange>();
+        LabelChange->Reserve(ActorsToRename.Num(), ActorsToRename.Num() * 64);
+    }
 
     for (int32 i = 0; i < ActorsToRename.Num(); ++i)
     {
         AActor* Actor = ActorsToRename[i];
         if (!Actor) continue;
 
-        Actor->Modify(); // mark actor as modified for undo/redo
         FString OldLabel = Actor->GetActorLabel();
-        FString NewLabel = GenerateNewName(OldLabel, Options, i);
-        Actor->SetActorLabel(NewLabel, true);
+        FString NewLabel = MoveTemp(NewLabels[i]);
+        // SetActorLabel may rename the object as well, which the undo record has to put back
+        const FName OldObjectName = Actor->GetFName();
+        {
+            TGuardValue<ITransaction*> SuppressSnapshot(GUndo, LabelChange.IsValid() ? nullptr : GUndo);
+            Actor->SetActorLabel(NewLabel, true);
+        }
+        if (Options.bSaveOnApply)
+        {
+            // the level package, or the actor's own one when actors are saved as external packages
+            DirtyPackages.Add(Actor->GetPackage());
+        }
+        if (LabelChange.IsValid())
+        {
+            LabelChange->Add(Actor, OldLabel, NewLabel, OldObjectName, Actor->GetFName());
+            ChangeWorld = ChangeWorld ? ChangeWorld : Actor->GetWorld();
+        }
         
         UE_LOG(LogTemp, Log, TEXT("Renamed actor: '%s' -> '%s'"), *OldLabel, *NewLabel);
-        SuccessCount++;
+
+        FRenameItemResult& Item = Result.Items.AddDefaulted_GetRef();
+        Item.OldName = MoveTemp(OldLabel);
+        Item.NewName = MoveTemp(NewLabel);
+        Item.bSuccess = true;
+        Result.SuccessCount++;
+    }
+
+    // the whole batch is one record of the transaction, ctrl+z and ctrl+y replay it in one pass
+    if (LabelChange.IsValid() && LabelChange->Num() > 0 && ChangeWorld && GUndo)
+    {
+        GUndo->StoreUndo(ChangeWorld, MoveTemp(LabelChange));
+    }
+
+    if (Options.bSaveOnApply && Result.SuccessCount > 0)
+    {
+        Transaction.Reset();
+        DirtyPackages.Save(Result);
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Actor rename completed. Success: %d"), SuccessCount);
+    UE_LOG(LogTemp, Log, TEXT("Actor rename completed. Success: %d"), Result.SuccessCount);
+    return Result;
 }
\ No newline at end of file
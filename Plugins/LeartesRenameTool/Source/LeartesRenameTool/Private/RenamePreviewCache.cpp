@@ -0,0 +1,201 @@
+#include "RenamePreviewCache.h"
+#include "ActorLabelIndex.h"
+#include "AssetNameIndex.h"
+
+// recent option sets whose rows are kept, and the row budget they share
+static constexpr int32 MaxCachedOptionSets = 8;
+static constexpr int32 MaxCachedRows = 1 << 20;
+
+void FRenamePreviewCache::Reset()
+{
+	AssetStage.Reset();
+	ActorStage.Reset();
+	CarriedAssetStage.Reset();
+	CarriedActorStage.Reset();
+	AssetScopes.Reset();
+	ActorScopes.Reset();
+	RecentRows.Empty();
+}
+
+const FRenamePreviewRows* FRenamePreviewCache::FindRows(const FRenameOptions& Options) const
+{
+	// collision flags in the rows are only valid for the index state they were looked up against
+	const uint32 AssetIndexVersion = FAssetNameIndex::Get().GetVersion();
+	const uint32 ActorIndexVersion = FActorLabelIndex::Get().GetVersion();
+
+	for (int32 i = RecentRows.Num() - 1; i >= 0; --i)
+	{
+		const FCachedRows& Cached = RecentRows[i];
+		if (HasSamePreviewOptions(Cached.Options, Options)
+			&& (!Options.bApplyToAssets || Cached.AssetIndexVersion == AssetIndexVersion)
+			&& (!Options.bApplyToActors || Cached.ActorIndexVersion == ActorIndexVersion))
+		{
+			return &Cached.Rows;
+		}
+	}
+	return nullptr;
+}
+
+void FRenamePreviewCache::Store(const FRenamePreviewJob& Job, const FRenamePreviewRows& Rows)
+{
+	if (!Job.IsComplete()) return;
+
+	// a kind the job did not cover keeps its older stage
+	if (Job.GetAssetStage().IsValid())
+	{
+		AssetStage = Job.GetAssetStage();
+	}
+	if (Job.GetActorStage().IsValid())
+	{
+		ActorStage = Job.GetActorStage();
+	}
+
+	if (Rows.Num() > MaxCachedRows) return;
+
+	RecentRows.RemoveAll([&Job](const FCachedRows& Cached) { return HasSamePreviewOptions(Cached.Options, Job.GetOptions()); });
+
+	FCachedRows& Cached = RecentRows.AddDefaulted_GetRef();
+	Cached.Options = Job.GetOptions();
+	Cached.AssetIndexVersion = Job.GetAssetIndexVersion();
+	Cached.ActorIndexVersion = Job.GetActorIndexVersion();
+	Cached.Rows = Rows;
+
+	// drop the oldest option sets until both limits hold again
+	int32 TotalRows = 0;
+	for (const FCachedRows& It : RecentRows)
+	{
+		TotalRows += It.Rows.Num();
+	}
+	while (RecentRows.Num() > MaxCachedOptionSets || TotalRows > MaxCachedRows)
+	{
+		TotalRows -= RecentRows[0].Rows.Num();
+		RecentRows.RemoveAt(0);
+	}
+}
+
+void FRenamePreviewCache::RemapItems(ERenameItemKind Kind, TConstArrayView<int32> OldIndices)
+{
+	// rows are stored by item position, which just changed
+	RecentRows.Empty();
+
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe>& Finished = Kind == ERenameItemKind::Asset ? AssetStage : ActorStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& Carried = Kind == ERenameItemKind::Asset ? CarriedAssetStage : CarriedActorStage;
+
+	// a carried stage is the cache's alone, a finished one may still be read by a job that has not let go of it yet,
+	// stages are only ever created mutable, so one nothing else holds can be taken apart
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> Owned = Carried;
+	if (!Owned.IsValid() && Finished.IsUnique())
+	{
+		Owned = ConstCastSharedPtr<FRenamePreviewStage>(Finished);
+	}
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> Source = Finished;
+	if (Carried.IsValid())
+	{
+		Source = Carried;
+	}
+	Carried.Reset();
+	Finished.Reset();
+	if (!Source.IsValid() || !Source->BaseNames.IsValid()) return;
+
+	const FRenamePreviewStage& Old = *Source;
+	// base names may be shared with a stage built on the same options, they only move when this stage holds the last reference
+	TArray<FString>* OwnedBaseNames = Owned.IsValid() && Old.BaseNames.IsUnique() ? ConstCastSharedPtr<TArray<FString>>(Old.BaseNames).Get() : nullptr;
+	const bool bOwnedNames = Owned.IsValid();
+	// counts view the old strings, they carry over only when the strings move
+	const bool bKeepCounts = bOwnedNames && Old.bNamesCounted;
+
+	const int32 NumItems = OldIndices.Num();
+	TSharedRef<FRenamePreviewStage, ESPMode::ThreadSafe> New = MakeShared<FRenamePreviewStage, ESPMode::ThreadSafe>();
+	New->Find = Old.Find;
+	New->Replace = Old.Replace;
+	New->ReplaceRules = Old.ReplaceRules;
+	New->bFindRegex = Old.bFindRegex;
+	New->bFindIgnoreCase = Old.bFindIgnoreCase;
+	New->CaseOp = Old.CaseOp;
+	New->Prefix = Old.Prefix;
+	New->Suffix = Old.Suffix;
+	New->bUseNumbering = Old.bUseNumbering;
+	New->StartNumber = Old.StartNumber;
+	New->Padding = Old.Padding;
+	New->IndexVersion = Old.IndexVersion;
+	New->MissingBases.Init(false, NumItems);
+	New->Names.SetNum(NumItems);
+	New->Collisions.SetNumZeroed(NumItems);
+	New->Scopes.Init(INDEX_NONE, NumItems);
+
+	// an added item gets an empty name, which no lookup ever matched, so it is looked up again as well
+	// an item the old stage skipped never got a name either and is treated as added
+	TSharedRef<TArray<FString>, ESPMode::ThreadSafe> BaseNames = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+	BaseNames->SetNum(NumItems);
+	TBitArray<> Kept(false, Old.BaseNames->Num());
+	for (int32 i = 0; i < NumItems; ++i)
+	{
+		const int32 OldIndex = OldIndices[i];
+		if (!Old.BaseNames->IsValidIndex(OldIndex) || (Old.MissingBases.IsValidIndex(OldIndex) && Old.MissingBases[OldIndex])
+			|| !Old.Scopes.IsValidIndex(OldIndex) || Old.Scopes[OldIndex] == INDEX_NONE)
+		{
+			New->MissingBases[i] = true;
+			continue;
+		}
+		Kept[OldIndex] = true;
+
+		(*BaseNames)[i] = OwnedBaseNames ? MoveTemp((*OwnedBaseNames)[OldIndex]) : (*Old.BaseNames)[OldIndex];
+		if (Old.Names.IsValidIndex(OldIndex))
+		{
+			New->Names[i] = bOwnedNames ? MoveTemp(Owned->Names[OldIndex]) : Old.Names[OldIndex];
+			New->Collisions[i] = Old.Collisions[OldIndex];
+			New->Scopes[i] = Old.Scopes[OldIndex];
+		}
+	}
+	New->BaseNames = BaseNames;
+
+	if (bKeepCounts)
+	{
+		// items that left are uncounted, their strings stay alive in case a key of a name still counted views them
+		New->NameCounts = MoveTemp(Owned->NameCounts);
+		New->RetiredNames = MoveTemp(Owned->RetiredNames);
+		for (int32 OldIndex = 0; OldIndex < Old.Scopes.Num(); ++OldIndex)
+		{
+			if (Kept[OldIndex] || Old.Scopes[OldIndex] == INDEX_NONE) continue;
+
+			New->NameCounts.Remove(Old.Scopes[OldIndex], Owned->Names[OldIndex]);
+			New->RetiredNames.Add(MoveTemp(Owned->Names[OldIndex]));
+		}
+		New->bNamesCounted = true;
+	}
+	Carried = New;
+}
+
+TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> FRenamePreviewCache::TakeCarriedStage(ERenameItemKind Kind)
+{
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& Carried = Kind == ERenameItemKind::Asset ? CarriedAssetStage : CarriedActorStage;
+	return MoveTemp(Carried);
+}
+
+int32 FRenamePreviewCache::GetAssetScope(FName PackagePath)
+{
+	return AssetScopes.FindOrAdd(PackagePath, AssetScopes.Num());
+}
+
+int32 FRenamePreviewCache::GetActorScope(const UWorld* World)
+{
+	return ActorScopes.FindOrAdd(World, ActorScopes.Num());
+}
+
+//options that change the preview rows, apply-only options such as dry run are ignored
+bool FRenamePreviewCache::HasSamePreviewOptions(const FRenameOptions& A, const FRenameOptions& B)
+{
+	return A.Prefix.Equals(B.Prefix, ESearchCase::CaseSensitive)
+		&& A.Suffix.Equals(B.Suffix, ESearchCase::CaseSensitive)
+		&& A.Find.Equals(B.Find, ESearchCase::CaseSensitive)
+		&& A.Replace.Equals(B.Replace, ESearchCase::CaseSensitive)
+		&& A.ReplaceRules == B.ReplaceRules
+		&& A.bFindRegex == B.bFindRegex
+		&& A.bFindIgnoreCase == B.bFindIgnoreCase
+		&& A.bUseNumbering == B.bUseNumbering
+		&& (!A.bUseNumbering || (A.StartNumber == B.StartNumber && A.Padding == B.Padding))
+		&& A.CaseOp == B.CaseOp
+		&& A.bApplyToAssets == B.bApplyToAssets
+		&& A.bApplyToActors == B.bApplyToActors
+		&& A.bResolveDuplicates == B.bResolveDuplicates;
+}
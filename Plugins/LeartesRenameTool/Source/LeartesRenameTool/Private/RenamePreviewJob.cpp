@@ -0,0 +1,379 @@
+#include "RenamePreviewJob.h"
+#include "ActorLabelIndex.h"
+#include "AssetNameIndex.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ScopeLock.h"
+#include "RenameLogic.h"
+#include "RenameNamePlan.h"
+#include "RenamePreviewCache.h"
+
+// items per chunk, the unit of parallel work and of cancellation checks
+static constexpr int32 PreviewJobChunkSize = 2048;
+
+// bring the per scope name counts of a finished stage up to date, a stage whose kept names did not change only
+// counts its added items and the ones that changed scope, anything else is counted from scratch
+// the retired names of items that left are dropped on a full count, which also runs once they outnumber the items
+static void CountStageNames(FRenamePreviewStage& Stage, const TArray<int32>& Scopes, ESearchCase::Type SearchCase, bool bKeptNames)
+{
+	if (bKeptNames && Stage.bNamesCounted && Stage.RetiredNames.Num() <= Scopes.Num())
+	{
+		for (int32 i = 0; i < Scopes.Num(); ++i)
+		{
+			if (Stage.Scopes[i] == Scopes[i]) continue;
+
+			if (Stage.Scopes[i] != INDEX_NONE)
+			{
+				Stage.NameCounts.Remove(Stage.Scopes[i], Stage.Names[i]);
+			}
+			if (Scopes[i] != INDEX_NONE)
+			{
+				Stage.NameCounts.Add(Scopes[i], Stage.Names[i]);
+			}
+		}
+	}
+	else
+	{
+		Stage.NameCounts = FRenameNameCounts(SearchCase);
+		Stage.RetiredNames.Empty();
+		for (int32 i = 0; i < Scopes.Num(); ++i)
+		{
+			if (Scopes[i] == INDEX_NONE) continue;
+			Stage.NameCounts.Add(Scopes[i], Stage.Names[i]);
+		}
+	}
+	Stage.Scopes = Scopes;
+	Stage.bNamesCounted = true;
+}
+
+FRenamePreviewJob::FRenamePreviewJob(TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> InGeneration)
+	: Generation(MoveTemp(InGeneration))
+	, LaunchGeneration(Generation->GetValue())
+{
+}
+
+TSharedRef<FRenamePreviewJob, ESPMode::ThreadSafe> FRenamePreviewJob::Launch(const TArray<FAssetData>& Assets, const TArray<AActor*>& Actors,
+	const FRenameOptions& Options, FRenamePreviewCache& Cache, TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Generation)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FRenamePreviewJob, ESPMode::ThreadSafe> Job = MakeShared<FRenamePreviewJob, ESPMode::ThreadSafe>(MoveTemp(Generation));
+	Job->Options = Options;
+
+	if (Options.bApplyToAssets)
+	{
+		// target paths are snapshotted here so the worker only reads the index
+		FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+		TMap<FName, int32> PathScopes;
+
+		Job->AssetItems = Assets;
+		Job->AssetScopes.Init(INDEX_NONE, Assets.Num());
+		for (int32 i = 0; i < Assets.Num(); ++i)
+		{
+			const FAssetData& AD = Assets[i];
+			if (!AD.IsValid()) continue;
+
+			const int32* Scope = PathScopes.Find(AD.PackagePath);
+			if (!Scope)
+			{
+				NameIndex.EnsurePath(AD.PackagePath);
+				Scope = &PathScopes.Add(AD.PackagePath, Cache.GetAssetScope(AD.PackagePath));
+			}
+			Job->AssetScopes[i] = *Scope;
+		}
+
+		Job->PrevAssetStage = Cache.GetAssetStage();
+		Job->CarriedAssetStage = Cache.TakeCarriedStage(ERenameItemKind::Asset);
+		Job->AssetIndexVersion = NameIndex.GetVersion();
+	}
+
+	if (Options.bApplyToActors)
+	{
+		// labels are copied here because GetActorLabel may create a default one, and worlds are indexed up front
+		FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+		TMap<UWorld*, int32> WorldScopes;
+
+		Job->ActorItems.SetNum(Actors.Num());
+		Job->ActorScopes.Init(INDEX_NONE, Actors.Num());
+		for (int32 i = 0; i < Actors.Num(); ++i)
+		{
+			AActor* Actor = Actors[i];
+			if (!Actor) continue;
+
+			UWorld* World = Actor->GetWorld();
+			const int32* Scope = WorldScopes.Find(World);
+			if (!Scope)
+			{
+				LabelIndex.EnsureWorld(World);
+				Scope = &WorldScopes.Add(World, Cache.GetActorScope(World));
+			}
+			Job->ActorScopes[i] = *Scope;
+
+			FActorItem& Item = Job->ActorItems[i];
+			Item.Label = Actor->GetActorLabel();
+			Item.World = World;
+			Item.Actor = Actor;
+		}
+
+		Job->PrevActorStage = Cache.GetActorStage();
+		Job->CarriedActorStage = Cache.TakeCarriedStage(ERenameItemKind::Actor);
+		Job->ActorIndexVersion = LabelIndex.GetVersion();
+	}
+
+	Job->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]() { Job->Run(); }, UE::Tasks::ETaskPriority::BackgroundNormal);
+	return Job;
+}
+
+bool FRenamePreviewJob::ConsumeResults(FRenamePreviewRows& OutRows, TArray<FRenamePreviewPatch>& OutPatches)
+{
+	FScopeLock Lock(&ResultsLock);
+
+	OutRows.Append(PendingRows);
+	PendingRows.Reset();
+	OutPatches.Append(MoveTemp(PendingPatches));
+	PendingPatches.Reset();
+
+	return bFinished;
+}
+
+void FRenamePreviewJob::Wait()
+{
+	if (Task.IsValid())
+	{
+		Task.Wait();
+	}
+}
+
+void FRenamePreviewJob::Run()
+{
+	FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+	FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+
+	auto IsAssetNameTaken = [this, &NameIndex](int32 Item, const FString& Name)
+	{
+		return NameIndex.DoesPackageExist(AssetItems[Item].PackagePath, Name);
+	};
+	auto IsActorLabelTaken = [this, &LabelIndex](int32 Item, const FString& Name)
+	{
+		return LabelIndex.IsLabelUsed(ActorItems[Item].World, Name, ActorItems[Item].Actor);
+	};
+
+	// assets first, then actors, the same order the synchronous preview used
+	TArray<int32> AssetRows;
+	bool bCompleted = RunItems(ERenameItemKind::Asset, AssetScopes, 0, PrevAssetStage.Get(), CarriedAssetStage, AssetIndexVersion, ESearchCase::IgnoreCase,
+		[this](int32 Item, FNameBuilder& Scratch) -> FStringView
+		{
+			Scratch.Reset();
+			AssetItems[Item].AssetName.AppendString(Scratch);
+			return Scratch.ToView();
+		},
+		IsAssetNameTaken, AssetStage, AssetRows);
+
+	TArray<int32> ActorRows;
+	bCompleted = bCompleted && RunItems(ERenameItemKind::Actor, ActorScopes, AssetScopes.Num(), PrevActorStage.Get(), CarriedActorStage, ActorIndexVersion, ESearchCase::CaseSensitive,
+		[this](int32 Item, FNameBuilder& Scratch) -> FStringView { return ActorItems[Item].Label; },
+		IsActorLabelTaken, ActorStage, ActorRows);
+
+	// duplicates need every name of the batch, so they arrive as patches after the last row
+	if (bCompleted && !IsCancelled())
+	{
+		PublishDuplicatePatches(*AssetStage, AssetScopes, AssetRows, IsAssetNameTaken);
+		PublishDuplicatePatches(*ActorStage, ActorScopes, ActorRows, IsActorLabelTaken);
+	}
+
+	// a kind that was not requested keeps no stage, so the cache holds on to its previous one
+	if (!Options.bApplyToAssets) AssetStage.Reset();
+	if (!Options.bApplyToActors) ActorStage.Reset();
+
+	FScopeLock Lock(&ResultsLock);
+	bComplete = bCompleted && !IsCancelled();
+	bFinished = true;
+}
+
+bool FRenamePreviewJob::RunItems(ERenameItemKind Kind, const TArray<int32>& Scopes, int32 SourceOffset, const FRenamePreviewStage* PrevStage,
+	const TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& CarriedStage, uint32 IndexVersion, ESearchCase::Type SearchCase,
+	TFunctionRef<FStringView(int32, FNameBuilder&)> GetOldName, TFunctionRef<bool(int32, const FString&)> IsTaken,
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& OutStage, TArray<int32>& OutRowIndices)
+{
+	const int32 NumItems = Scopes.Num();
+
+	// kept items of a carried stage have their base names, and their names and lookups while the prefix, suffix and
+	// index did not change either, numbering goes by item index, which moves when items leave
+	const bool bCarried = CarriedStage.IsValid() && CarriedStage->HasSameBase(Options, NumItems);
+	const bool bKeepNames = bCarried && !Options.bUseNumbering && CarriedStage->HasSameCompose(Options);
+	const bool bKeepLookups = bKeepNames && CarriedStage->IndexVersion == IndexVersion;
+
+	// find/replace and case only rerun when one of their options changed
+	TSharedPtr<TArray<FString>, ESPMode::ThreadSafe> NewBaseNames;
+	const TBitArray<>* MissingBases = nullptr;
+	if (bCarried)
+	{
+		// only the items added since go through find/replace and case, straight into the carried base names,
+		// which the cache built for this stage alone and handed over with it
+		OutStage = CarriedStage;
+		NewBaseNames = ConstCastSharedPtr<TArray<FString>>(OutStage->BaseNames);
+		MissingBases = &OutStage->MissingBases;
+	}
+	else
+	{
+		OutStage = MakeShared<FRenamePreviewStage, ESPMode::ThreadSafe>();
+		OutStage->Names.SetNum(NumItems);
+		OutStage->Collisions.Init(false, NumItems);
+		if (PrevStage && PrevStage->HasSameBase(Options, NumItems))
+		{
+			OutStage->BaseNames = PrevStage->BaseNames;
+		}
+		else
+		{
+			NewBaseNames = MakeShared<TArray<FString>, ESPMode::ThreadSafe>();
+			NewBaseNames->SetNum(NumItems);
+			OutStage->BaseNames = NewBaseNames;
+		}
+	}
+
+	FRenamePreviewStage& Stage = *OutStage;
+	Stage.Find = Options.Find;
+	Stage.Replace = Options.Replace;
+	Stage.ReplaceRules = Options.ReplaceRules;
+	Stage.bFindRegex = Options.bFindRegex;
+	Stage.bFindIgnoreCase = Options.bFindIgnoreCase;
+	Stage.CaseOp = Options.CaseOp;
+	Stage.Prefix = Options.Prefix;
+	Stage.Suffix = Options.Suffix;
+	Stage.bUseNumbering = Options.bUseNumbering;
+	Stage.StartNumber = Options.StartNumber;
+	Stage.Padding = Options.Padding;
+	Stage.IndexVersion = IndexVersion;
+	OutRowIndices.Init(INDEX_NONE, NumItems);
+
+	// a name the previous stage already looked up against the same index state keeps its answer
+	const FRenamePreviewStage* PrevLookups = !bCarried && PrevStage && PrevStage->IndexVersion == IndexVersion && PrevStage->Names.Num() == NumItems ? PrevStage : nullptr;
+
+	const FRenameNamePlan BasePlan = FRenameNamePlan::BaseStage(Options);
+	const FRenameNamePlan ComposePlan = FRenameNamePlan::ComposeStage(Options);
+
+	auto BuildRows = [&](int32 Begin, int32 End, FRenamePreviewRows& Rows)
+	{
+		Rows.Reset();
+		FNameBuilder Scratch;
+		for (int32 i = Begin; i < End; ++i)
+		{
+			if (Scopes[i] == INDEX_NONE) continue;
+
+			const FStringView OldName = GetOldName(i, Scratch);
+			const bool bAdded = MissingBases && (*MissingBases)[i];
+			if (NewBaseNames.IsValid() && (!MissingBases || bAdded))
+			{
+				BasePlan.Generate(OldName, i, (*NewBaseNames)[i]);
+			}
+
+			FString& NewName = Stage.Names[i];
+			bool bCollision = false;
+			if (bKeepNames && !bAdded)
+			{
+				bCollision = bKeepLookups ? Stage.Collisions[i] : IsTaken(i, NewName);
+			}
+			else
+			{
+				ComposePlan.Generate((*Stage.BaseNames)[i], i, NewName);
+				bCollision = PrevLookups && PrevLookups->Names[i].Equals(NewName, ESearchCase::CaseSensitive)
+					? PrevLookups->Collisions[i]
+					: IsTaken(i, NewName);
+			}
+			Stage.Collisions[i] = bCollision;
+
+			Rows.Add(OldName, NewName, bCollision, Kind, SourceOffset + i);
+		}
+	};
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumItems, PreviewJobChunkSize);
+	const int32 ChunksPerWave = Options.bParallelPreview ? FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads()) : 1;
+
+	// one arena per chunk of a wave, reused by the next wave
+	TArray<FRenamePreviewRows> ChunkRows;
+	ChunkRows.SetNum(FMath::Min(ChunksPerWave, NumChunks));
+	for (int32 FirstChunk = 0; FirstChunk < NumChunks;)
+	{
+		if (IsCancelled()) return false;
+
+		// the first wave is a single chunk so the list fills right away, later waves keep every worker busy
+		const int32 WaveChunks = FirstChunk == 0 ? 1 : FMath::Min(ChunksPerWave, NumChunks - FirstChunk);
+		const int32 Begin = FirstChunk * PreviewJobChunkSize;
+		const int32 End = FMath::Min((FirstChunk + WaveChunks) * PreviewJobChunkSize, NumItems);
+
+		// each chunk fills its own arena, skipped items get no row
+		ParallelFor(WaveChunks, [Begin, End, &BuildRows, &ChunkRows](int32 Chunk)
+		{
+			const int32 ChunkBegin = Begin + Chunk * PreviewJobChunkSize;
+			BuildRows(ChunkBegin, FMath::Min(ChunkBegin + PreviewJobChunkSize, End), ChunkRows[Chunk]);
+		}, Options.bParallelPreview ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+		for (int32 Chunk = 0; Chunk < WaveChunks; ++Chunk)
+		{
+			const FRenamePreviewRows& Rows = ChunkRows[Chunk];
+			for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			{
+				OutRowIndices[Rows.GetSourceIndex(Row) - SourceOffset] = NumRows++;
+			}
+		}
+		Publish(MakeArrayView(ChunkRows.GetData(), WaveChunks));
+
+		FirstChunk += WaveChunks;
+	}
+
+	Stage.MissingBases.Empty();
+	CountStageNames(Stage, Scopes, SearchCase, bKeepNames);
+	return true;
+}
+
+void FRenamePreviewJob::PublishDuplicatePatches(FRenamePreviewStage& Stage, const TArray<int32>& Scopes, const TArray<int32>& RowIndices,
+	TFunctionRef<bool(int32, const FString&)> IsTaken)
+{
+	if (Stage.Names.Num() < 2) return;
+
+	// the stage keeps the planned names, resolving works on a copy
+	TArray<FString> ResolvedNames;
+	if (Options.bResolveDuplicates)
+	{
+		ResolvedNames = Stage.Names;
+	}
+	TArray<FString>& Names = Options.bResolveDuplicates ? ResolvedNames : Stage.Names;
+
+	// without resolving the names are only counted, never written
+	TBitArray<> Duplicates;
+	FRenameLogic::ResolveBatchDuplicates(Names, Scopes, Stage.NameCounts, Options.bResolveDuplicates, IsTaken, Duplicates);
+
+	TArray<FRenamePreviewPatch> Patches;
+	for (int32 i = 0; i < Names.Num(); ++i)
+	{
+		if (RowIndices[i] == INDEX_NONE) continue;
+
+		const bool bResolved = Options.bResolveDuplicates && !Stage.Names[i].Equals(Names[i], ESearchCase::CaseSensitive);
+		if (!bResolved && !Duplicates[i]) continue;
+
+		FRenamePreviewPatch& Patch = Patches.AddDefaulted_GetRef();
+		Patch.Row = RowIndices[i];
+		Patch.bBatchDuplicate = Duplicates[i];
+		Patch.bResolved = bResolved;
+		if (bResolved)
+		{
+			Patch.NewName = MoveTemp(Names[i]);
+		}
+	}
+
+	if (Patches.Num() == 0) return;
+
+	FScopeLock Lock(&ResultsLock);
+	PendingPatches.Append(MoveTemp(Patches));
+}
+
+void FRenamePreviewJob::Publish(TArrayView<const FRenamePreviewRows> ChunkRows)
+{
+	FScopeLock Lock(&ResultsLock);
+	for (const FRenamePreviewRows& Rows : ChunkRows)
+	{
+		PendingRows.Append(Rows);
+	}
+}
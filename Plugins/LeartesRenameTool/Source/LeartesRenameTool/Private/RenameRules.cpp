@@ -0,0 +1,172 @@
+#include "RenameRules.h"
+#include "Algo/Find.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Class.h"
+
+namespace RenameRules
+{
+	static const TCHAR* RuleFields[] =
+	{
+		TEXT("name"), TEXT("paths"), TEXT("recursivePaths"), TEXT("classes"), TEXT("recursiveClasses"),
+		TEXT("prefix"), TEXT("suffix"), TEXT("find"), TEXT("replace"), TEXT("replaceRules"), TEXT("regex"), TEXT("ignoreCase"), TEXT("case"),
+		TEXT("useNumbering"), TEXT("startNumber"), TEXT("padding"), TEXT("resolveDuplicates"), TEXT("bulkChunkSize"),
+		TEXT("fixupRedirectors")
+	};
+
+	// accepts full class paths, and short names as long as they are unambiguous
+	static bool ParseClassPath(const FString& ClassName, FTopLevelAssetPath& OutPath)
+	{
+		if (ClassName.Contains(TEXT("/")))
+		{
+			OutPath = FTopLevelAssetPath(ClassName);
+		}
+		else
+		{
+			OutPath = UClass::TryConvertShortTypeNameToPathName<UClass>(ClassName, ELogVerbosity::Warning, TEXT("LeartesRename rules"));
+		}
+		return OutPath.IsValid();
+	}
+
+	static bool ParseRule(const FJsonObject& Json, int32 RuleIndex, bool bRequirePaths, FRenameRule& OutRule)
+	{
+		// an unknown field is most likely a typo, which would otherwise silently rename with defaults
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Json.Values)
+		{
+			if (!Algo::FindByPredicate(RuleFields, [&Field](const TCHAR* Known) { return Field.Key.Equals(Known, ESearchCase::CaseSensitive); }))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Rule %d: unknown field '%s'"), RuleIndex, *Field.Key);
+				return false;
+			}
+		}
+
+		if (!Json.TryGetStringField(TEXT("name"), OutRule.Name))
+		{
+			OutRule.Name = FString::Printf(TEXT("Rule %d"), RuleIndex);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Paths = nullptr;
+		if (Json.TryGetArrayField(TEXT("paths"), Paths))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Paths)
+			{
+				FString Path;
+				if (!Value->TryGetString(Path) || !FPackageName::IsValidPath(Path))
+				{
+					UE_LOG(LogTemp, Error, TEXT("%s: '%s' is not a valid content path"), *OutRule.Name, *Path);
+					return false;
+				}
+				OutRule.Paths.Add(FName(*Path));
+			}
+		}
+		if (bRequirePaths && OutRule.Paths.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: needs at least one entry in 'paths'"), *OutRule.Name);
+			return false;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Classes = nullptr;
+		if (Json.TryGetArrayField(TEXT("classes"), Classes))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Classes)
+			{
+				FString ClassName;
+				FTopLevelAssetPath ClassPath;
+				if (!Value->TryGetString(ClassName) || !ParseClassPath(ClassName, ClassPath))
+				{
+					UE_LOG(LogTemp, Error, TEXT("%s: unknown class '%s'"), *OutRule.Name, *ClassName);
+					return false;
+				}
+				OutRule.Classes.Add(ClassPath);
+			}
+		}
+
+		Json.TryGetBoolField(TEXT("recursivePaths"), OutRule.bRecursivePaths);
+		Json.TryGetBoolField(TEXT("recursiveClasses"), OutRule.bRecursiveClasses);
+
+		FRenameOptions& Options = OutRule.Options;
+		Json.TryGetStringField(TEXT("prefix"), Options.Prefix);
+		Json.TryGetStringField(TEXT("suffix"), Options.Suffix);
+		Json.TryGetStringField(TEXT("find"), Options.Find);
+		Json.TryGetStringField(TEXT("replace"), Options.Replace);
+		Json.TryGetBoolField(TEXT("regex"), Options.bFindRegex);
+		Json.TryGetBoolField(TEXT("ignoreCase"), Options.bFindIgnoreCase);
+
+		const TArray<TSharedPtr<FJsonValue>>* ReplaceRules = nullptr;
+		if (Json.TryGetArrayField(TEXT("replaceRules"), ReplaceRules))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *ReplaceRules)
+			{
+				const TSharedPtr<FJsonObject>* RuleObject = nullptr;
+				FRenameReplaceRule& ReplaceRule = Options.ReplaceRules.AddDefaulted_GetRef();
+				if (!Value->TryGetObject(RuleObject) || !(*RuleObject)->TryGetStringField(TEXT("find"), ReplaceRule.Find))
+				{
+					UE_LOG(LogTemp, Error, TEXT("%s: every entry of 'replaceRules' needs a 'find' string"), *OutRule.Name);
+					return false;
+				}
+				(*RuleObject)->TryGetStringField(TEXT("replace"), ReplaceRule.Replace);
+			}
+		}
+		Json.TryGetBoolField(TEXT("useNumbering"), Options.bUseNumbering);
+		Json.TryGetNumberField(TEXT("startNumber"), Options.StartNumber);
+		Json.TryGetNumberField(TEXT("padding"), Options.Padding);
+		Json.TryGetBoolField(TEXT("resolveDuplicates"), Options.bResolveDuplicates);
+		Json.TryGetNumberField(TEXT("bulkChunkSize"), Options.BulkRenameChunkSize);
+		Json.TryGetBoolField(TEXT("fixupRedirectors"), Options.bFixupRedirectors);
+
+		FString CaseName;
+		if (Json.TryGetStringField(TEXT("case"), CaseName) && !LexTryParseString(Options.CaseOp, *CaseName))
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: unknown case '%s'"), *OutRule.Name, *CaseName);
+			return false;
+		}
+
+		// unattended runs apply without an undo history and update the registry synchronously
+		Options.bDryRun = false;
+		Options.bDeferRegistryUpdate = false;
+		Options.bTransactional = false;
+		return true;
+	}
+}
+
+bool RenameRules::LoadFromFile(const FString& Path, bool bRequirePaths, TArray<FRenameRule>& OutRules)
+{
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not read rules file %s"), *Path);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rules file %s is not valid json"), *Path);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Rules = nullptr;
+	if (!Root->TryGetArrayField(TEXT("rules"), Rules) || Rules->Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Rules file %s has no 'rules' array"), *Path);
+		return false;
+	}
+
+	for (int32 i = 0; i < Rules->Num(); ++i)
+	{
+		const TSharedPtr<FJsonObject>* RuleObject = nullptr;
+		if (!(*Rules)[i]->TryGetObject(RuleObject))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Rule %d is not an object"), i);
+			return false;
+		}
+		if (!ParseRule(**RuleObject, i, bRequirePaths, OutRules.AddDefaulted_GetRef()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -3,8 +3,12 @@
 #include "RenameTypes.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Text/STextBlock.h"
+#include "Widgets/Text/SRichTextBlock.h"
+#include "LeartesRenameToolStyle.h"
+#include "RenameNameDiff.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SUniformGridPanel.h"
@@ -17,16 +21,166 @@
 #include "Engine/Selection.h"
 #include "EngineUtils.h"
 #include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
 #include "AssetRegistry/AssetRegistryModule.h" 
 #include "AssetRegistry/IAssetRegistry.h" 
 #include "TimerManager.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/ScopedSlowTask.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+// pause in typing after which the live preview is refreshed, in seconds
+static constexpr float LivePreviewDelay = 0.15f;
+
+// rows whose diff texts are kept, a few screens worth
+static constexpr int32 MaxCachedPreviewDiffs = 4096;
+
+// package names listed in the apply notification, the rest go to the log only
+static constexpr int32 MaxNotifiedSaveFailures = 5;
+
+// preview list columns
+namespace PreviewColumns
+{
+    static const FName OldName(TEXT("OldName"));
+    static const FName NewName(TEXT("NewName"));
+    static const FName Status(TEXT("Status"));
+    static const FName Kind(TEXT("Kind"));
+
+    static ERenamePreviewColumn ToViewColumn(const FName& ColumnId)
+    {
+        if (ColumnId == OldName) return ERenamePreviewColumn::OldName;
+        if (ColumnId == NewName) return ERenamePreviewColumn::NewName;
+        if (ColumnId == Status) return ERenamePreviewColumn::Status;
+        if (ColumnId == Kind) return ERenamePreviewColumn::Kind;
+        return ERenamePreviewColumn::None;
+    }
+}
+
+//rich text of one side of a preview row, the changed spans are tagged with the diff styles
+static FText MakePreviewDiffText(FStringView Name, const FRenameNameDiff& Spans, bool bNewName)
+{
+    TStringBuilder<256> Markup;
+    auto AppendEscaped = [&Markup](FStringView Text)
+    {
+        for (TCHAR C : Text)
+        {
+            switch (C)
+            {
+            case TEXT('&'): Markup << TEXT("&amp;"); break;
+            case TEXT('<'): Markup << TEXT("&lt;"); break;
+            case TEXT('>'): Markup << TEXT("&gt;"); break;
+            case TEXT('"'): Markup << TEXT("&quot;"); break;
+            default: Markup.AppendChar(C); break;
+            }
+        }
+    };
+
+    for (const FRenameDiffSpan& Span : Spans)
+    {
+        const FStringView Text = bNewName ? Name.Mid(Span.NewStart, Span.NewLen) : Name.Mid(Span.OldStart, Span.OldLen);
+        if (Text.IsEmpty()) continue;
+
+        if (Span.Op == ERenameDiffOp::Equal)
+        {
+            AppendEscaped(Text);
+            continue;
+        }
+
+        const TCHAR* Tag = Span.Op == ERenameDiffOp::Replace ? TEXT("LeartesRenameTool.Diff.Replaced")
+            : bNewName ? TEXT("LeartesRenameTool.Diff.Inserted")
+            : TEXT("LeartesRenameTool.Diff.Removed");
+        Markup << TEXT("<") << Tag << TEXT(">");
+        AppendEscaped(Text);
+        Markup << TEXT("</>");
+    }
+    return FText::FromString(FString(Markup.ToView()));
+}
+
+//one row of the preview list, the cell texts are made once when the row comes into view
+//the name columns are rich text with the changed characters highlighted
+class SRenamePreviewRow : public SMultiColumnTableRow<FRenamePreviewRowHandle>
+{
+public:
+    SLATE_BEGIN_ARGS(SRenamePreviewRow) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, const FRenamePreviewRows& Rows, int32 Row, const TPair<FText, FText>& DiffTexts)
+    {
+        static const FText AssetText = FText::FromString(TEXT("Asset"));
+        static const FText ActorText = FText::FromString(TEXT("Actor"));
+        static const FText OkText = FText::FromString(TEXT("OK"));
+        static const FText CollisionText = FText::FromString(TEXT("Collision"));
+        static const FText DuplicateText = FText::FromString(TEXT("Duplicate"));
+        static const FText BothText = FText::FromString(TEXT("Collision, Duplicate"));
+
+        const bool bCollision = Rows.IsCollision(Row);
+        const bool bDuplicate = Rows.IsBatchDuplicate(Row);
+        OldNameText = DiffTexts.Key;
+        NewNameText = DiffTexts.Value;
+        StatusText = bCollision ? (bDuplicate ? BothText : CollisionText) : (bDuplicate ? DuplicateText : OkText);
+        KindText = Rows.GetKind(Row) == ERenameItemKind::Actor ? ActorText : AssetText;
+        bProblem = bCollision || bDuplicate;
+
+        FSuperRowType::Construct(FSuperRowType::FArguments(), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        if (ColumnName == PreviewColumns::OldName || ColumnName == PreviewColumns::NewName)
+        {
+            const ISlateStyle& Style = FLeartesRenameToolStyle::Get();
+            return SNew(SRichTextBlock)
+                .Text(ColumnName == PreviewColumns::OldName ? OldNameText : NewNameText)
+                .TextStyle(&Style.GetWidgetStyle<FTextBlockStyle>("LeartesRenameTool.Diff.Normal"))
+                .DecoratorStyleSet(&Style);
+        }
+
+        const FText* Text = ColumnName == PreviewColumns::Status ? &StatusText : &KindText;
+
+        const bool bHighlight = bProblem && ColumnName == PreviewColumns::Status;
+        return SNew(STextBlock)
+            .Text(*Text)
+            .ColorAndOpacity(bHighlight ? FSlateColor(FLinearColor(1.f, 0.35f, 0.3f)) : FSlateColor::UseForeground());
+    }
+
+private:
+    FText OldNameText;
+    FText NewNameText;
+    FText StatusText;
+    FText KindText;
+    bool bProblem = false;
+};
+
+// one Find=Replace pair per line, split at the first '=' which asset names cannot contain
+static TArray<FRenameReplaceRule> ParseReplaceRules(const FString& Text)
+{
+    TArray<FString> Lines;
+    Text.ParseIntoArrayLines(Lines);
+
+    TArray<FRenameReplaceRule> Rules;
+    for (const FString& Line : Lines)
+    {
+        FString Find;
+        FString Replace;
+        if (Line.Split(TEXT("="), &Find, &Replace) && !Find.IsEmpty())
+        {
+            Rules.Add({ MoveTemp(Find), MoveTemp(Replace) });
+        }
+    }
+    return Rules;
+}
 
 //construct the widget and set up initial state
 void SLeartesRenameWidget::Construct(const FArguments& InArgs)
 {
+    const FText SaveOnApplyToolTip = FText::FromString(TEXT(
+        "Save the renamed assets, their redirectors and the changed levels right after the rename.\n"
+        "A saving rename keeps a recovery journal under Saved/ until every package is written.\n"
+        "Unchecked, renames stay in memory until you save, and a crash before that loses nothing."));
+
     // Default option state
     CurrentOptions = FRenameOptions();
     CurrentOptions.bDryRun = true;
@@ -41,6 +195,10 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
     CaseOptionsList.Add(MakeShared<FString>(TEXT("UPPERCASE")));
     CaseOptionsList.Add(MakeShared<FString>(TEXT("lowercase")));
     CaseOptionsList.Add(MakeShared<FString>(TEXT("CapitalizeFirst")));
+    CaseOptionsList.Add(MakeShared<FString>(TEXT("PascalCase")));
+    CaseOptionsList.Add(MakeShared<FString>(TEXT("snake_case")));
+    CaseOptionsList.Add(MakeShared<FString>(TEXT("camelCase")));
+    CaseOptionsList.Add(MakeShared<FString>(TEXT("Title_Case")));
     SelectedCaseItem = CaseOptionsList[0];
 
     // Build UI widgets with lambda bindings simple local cache
@@ -51,6 +209,7 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
             if (NewSelection.IsValid())
             {
                 SelectedCaseItem = NewSelection;
+                ScheduleLivePreview();
             }
         });
 
@@ -60,14 +219,14 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
         .MinValue(0)
         .MaxValue(999999)
         .Value_Lambda([this]() -> TOptional<int32> { return TOptional<int32>(CachedStartNumber); })
-        .OnValueChanged_Lambda([this](int32 NewValue) { CachedStartNumber = NewValue; });
+        .OnValueChanged_Lambda([this](int32 NewValue) { CachedStartNumber = NewValue; ScheduleLivePreview(); });
 
     PaddingEntry = SNew(SNumericEntryBox<int32>)
         .AllowSpin(true)
         .MinValue(1)
         .MaxValue(8)
         .Value_Lambda([this]() -> TOptional<int32> { return TOptional<int32>(CachedPadding); })
-        .OnValueChanged_Lambda([this](int32 NewValue) { CachedPadding = NewValue; });
+        .OnValueChanged_Lambda([this](int32 NewValue) { CachedPadding = NewValue; ScheduleLivePreview(); });
 
     // Use numbering checkbox triggers immediate preview refresh
     UseNumberingCheckBox = SNew(SCheckBox)
@@ -75,10 +234,26 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
         .OnCheckStateChanged(this, &SLeartesRenameWidget::OnUseNumberingChanged);
 
     // Preview list view
-    PreviewListView = SNew(SListView<TSharedPtr<FRenamePreviewItem>>)
+    PreviewListView = SNew(SListView<FRenamePreviewRowHandle>)
         .ListItemsSource(&PreviewItems)
         .OnGenerateRow(this, &SLeartesRenameWidget::OnGenerateRowForPreview)
-        .SelectionMode(ESelectionMode::None);
+        .SelectionMode(ESelectionMode::None)
+        .HeaderRow
+        (
+            SNew(SHeaderRow)
+            + SHeaderRow::Column(PreviewColumns::OldName).DefaultLabel(FText::FromString(TEXT("Old Name"))).FillWidth(0.36f)
+                .SortMode_Lambda([this]() { return GetPreviewSortMode(ERenamePreviewColumn::OldName); })
+                .OnSort(this, &SLeartesRenameWidget::OnPreviewSortChanged)
+            + SHeaderRow::Column(PreviewColumns::NewName).DefaultLabel(FText::FromString(TEXT("New Name"))).FillWidth(0.36f)
+                .SortMode_Lambda([this]() { return GetPreviewSortMode(ERenamePreviewColumn::NewName); })
+                .OnSort(this, &SLeartesRenameWidget::OnPreviewSortChanged)
+            + SHeaderRow::Column(PreviewColumns::Status).DefaultLabel(FText::FromString(TEXT("Status"))).FillWidth(0.18f)
+                .SortMode_Lambda([this]() { return GetPreviewSortMode(ERenamePreviewColumn::Status); })
+                .OnSort(this, &SLeartesRenameWidget::OnPreviewSortChanged)
+            + SHeaderRow::Column(PreviewColumns::Kind).DefaultLabel(FText::FromString(TEXT("Kind"))).FillWidth(0.1f)
+                .SortMode_Lambda([this]() { return GetPreviewSortMode(ERenamePreviewColumn::Kind); })
+                .OnSort(this, &SLeartesRenameWidget::OnPreviewSortChanged)
+        );
 
     // Main layout
     ChildSlot
@@ -121,7 +296,7 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
-                    SAssignNew(PrefixTextBox, SEditableTextBox)
+                    SAssignNew(PrefixTextBox, SEditableTextBox).OnTextChanged(this, &SLeartesRenameWidget::OnOptionTextChanged)
                 ]
 
                 // Suffix
@@ -131,7 +306,7 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
-                    SAssignNew(SuffixTextBox, SEditableTextBox)
+                    SAssignNew(SuffixTextBox, SEditableTextBox).OnTextChanged(this, &SLeartesRenameWidget::OnOptionTextChanged)
                 ]
 
                 // Find & Replace
@@ -141,7 +316,27 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
-                    SAssignNew(FindTextBox, SEditableTextBox)
+                    SAssignNew(FindTextBox, SEditableTextBox).OnTextChanged(this, &SLeartesRenameWidget::OnOptionTextChanged)
+                ]
+                + SVerticalBox::Slot().AutoHeight().Padding(2)
+                [
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+                    [
+                        SAssignNew(RegexCheckBox, SCheckBox).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(this, &SLeartesRenameWidget::OnOptionCheckChanged)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Regex ($1 in Replace inserts a group)")))
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(12,0,0,0)
+                    [
+                        SAssignNew(IgnoreCaseCheckBox, SCheckBox).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(this, &SLeartesRenameWidget::OnOptionCheckChanged)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Ignore Case")))
+                    ]
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
@@ -149,7 +344,18 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
-                    SAssignNew(ReplaceTextBox, SEditableTextBox)
+                    SAssignNew(ReplaceTextBox, SEditableTextBox).OnTextChanged(this, &SLeartesRenameWidget::OnOptionTextChanged)
+                ]
+                + SVerticalBox::Slot().AutoHeight().Padding(2)
+                [
+                    SNew(STextBlock).Text(FText::FromString(TEXT("More Rules (one Find=Replace per line)")))
+                ]
+                + SVerticalBox::Slot().AutoHeight().Padding(2)
+                [
+                    SNew(SBox).MaxDesiredHeight(96)
+                    [
+                        SAssignNew(ReplaceRulesTextBox, SMultiLineEditableTextBox).OnTextChanged(this, &SLeartesRenameWidget::OnOptionTextChanged)
+                    ]
                 ]
 
                 // Numbering row with checkbox
@@ -198,7 +404,7 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                     SNew(SHorizontalBox)
                     + SHorizontalBox::Slot().AutoWidth()
                     [
-                        SAssignNew(AssetsCheckBox, SCheckBox).IsChecked(ECheckBoxState::Checked)
+                        SAssignNew(AssetsCheckBox, SCheckBox).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(this, &SLeartesRenameWidget::OnOptionCheckChanged)
                     ]
                     + SHorizontalBox::Slot().AutoWidth().Padding(6,0)
                     [
@@ -210,7 +416,7 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                     SNew(SHorizontalBox)
                     + SHorizontalBox::Slot().AutoWidth()
                     [
-                        SAssignNew(ActorsCheckBox, SCheckBox).IsChecked(ECheckBoxState::Checked)
+                        SAssignNew(ActorsCheckBox, SCheckBox).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(this, &SLeartesRenameWidget::OnOptionCheckChanged)
                     ]
                     + SHorizontalBox::Slot().AutoWidth().Padding(6,0)
                     [
@@ -218,6 +424,18 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                     ]
                 ]
                 + SVerticalBox::Slot().AutoHeight().Padding(4)
+                [
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot().AutoWidth()
+                    [
+                        SAssignNew(ResolveDuplicatesCheckBox, SCheckBox).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(this, &SLeartesRenameWidget::OnOptionCheckChanged)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Resolve Duplicate Names")))
+                    ]
+                ]
+                + SVerticalBox::Slot().AutoHeight().Padding(4)
                 [
                     SNew(SHorizontalBox)
                     + SHorizontalBox::Slot().AutoWidth()
@@ -229,6 +447,32 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                         SNew(STextBlock).Text(FText::FromString(TEXT("Dry Run (Preview only)")))
                     ]
                 ]
+                + SVerticalBox::Slot().AutoHeight().Padding(4)
+                [
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot().AutoWidth()
+                    [
+                        SAssignNew(FixupRedirectorsCheckBox, SCheckBox).IsChecked(ECheckBoxState::Unchecked)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Fix Up Redirectors After Rename")))
+                    ]
+                ]
+                + SVerticalBox::Slot().AutoHeight().Padding(4)
+                [
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot().AutoWidth()
+                    [
+                        SAssignNew(SaveOnApplyCheckBox, SCheckBox).IsChecked(ECheckBoxState::Unchecked)
+                        .ToolTipText(SaveOnApplyToolTip)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Save Changed Packages After Rename")))
+                        .ToolTipText(SaveOnApplyToolTip)
+                    ]
+                ]
 
                 // Buttons
                 + SVerticalBox::Slot().AutoHeight().Padding(8)
@@ -255,7 +499,25 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
                 SNew(SVerticalBox)
                 + SVerticalBox::Slot().AutoHeight().Padding(2)
                 [
-                    SNew(STextBlock).Text(FText::FromString(TEXT("Preview (Old -> New)")))
+                    SNew(SHorizontalBox)
+                    + SHorizontalBox::Slot().FillWidth(1).VAlign(VAlign_Center)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Preview (Old -> New)")))
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0)
+                    [
+                        SAssignNew(PreviewCountText, STextBlock)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
+                    [
+                        SAssignNew(ProblemsOnlyCheckBox, SCheckBox)
+                        .IsChecked(ECheckBoxState::Unchecked)
+                        .OnCheckStateChanged(this, &SLeartesRenameWidget::OnProblemsOnlyChanged)
+                    ]
+                    + SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(6,0)
+                    [
+                        SNew(STextBlock).Text(FText::FromString(TEXT("Collisions only")))
+                    ]
                 ]
                 + SVerticalBox::Slot().FillHeight(1).Padding(2)
                 [
@@ -269,11 +531,44 @@ void SLeartesRenameWidget::Construct(const FArguments& InArgs)
         ]
     ];
 
+    // the selection is followed through its change events from here on, refresh reads it again from scratch
+    if (FModuleManager::Get().IsModuleLoaded("ContentBrowser"))
+    {
+        FContentBrowserModule& CBModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
+        AssetSelectionChangedHandle = CBModule.GetOnAssetSelectionChanged().AddSP(this, &SLeartesRenameWidget::OnAssetSelectionChanged);
+    }
+    ActorSelectObjectHandle = USelection::SelectObjectEvent.AddSP(this, &SLeartesRenameWidget::OnActorSelectObject);
+    ActorSelectNoneHandle = USelection::SelectNoneEvent.AddSP(this, &SLeartesRenameWidget::OnActorSelectNone);
+    ActorSelectionChangedHandle = USelection::SelectionChangedEvent.AddSP(this, &SLeartesRenameWidget::OnActorSelectionChanged);
+
     // Initial population
     RefreshSelection();
     RefreshPreview();
 }
 
+//stop the background preview before the widget goes away, it reads the shared indexes
+SLeartesRenameWidget::~SLeartesRenameWidget()
+{
+    if (GEditor)
+    {
+        GEditor->GetTimerManager()->ClearTimer(LivePreviewTimer);
+    }
+
+    if (FContentBrowserModule* CBModule = FModuleManager::GetModulePtr<FContentBrowserModule>("ContentBrowser"))
+    {
+        CBModule->GetOnAssetSelectionChanged().Remove(AssetSelectionChangedHandle);
+    }
+    USelection::SelectObjectEvent.Remove(ActorSelectObjectHandle);
+    USelection::SelectNoneEvent.Remove(ActorSelectNoneHandle);
+    USelection::SelectionChangedEvent.Remove(ActorSelectionChangedHandle);
+
+    CancelPreviewJob();
+    for (const TSharedPtr<FRenamePreviewJob, ESPMode::ThreadSafe>& Job : CancelledPreviewJobs)
+    {
+        Job->Wait();
+    }
+}
+
 //checkbox state change handler
 void SLeartesRenameWidget::OnUseNumberingChanged(ECheckBoxState NewState)
 {
@@ -282,38 +577,264 @@ void SLeartesRenameWidget::OnUseNumberingChanged(ECheckBoxState NewState)
     RefreshPreview();
 }
 
+//text option handler, every keystroke restarts the live preview delay
+void SLeartesRenameWidget::OnOptionTextChanged(const FText& NewText)
+{
+    ScheduleLivePreview();
+}
+
+void SLeartesRenameWidget::OnOptionCheckChanged(ECheckBoxState NewState)
+{
+    ScheduleLivePreview();
+}
+
+//refresh the preview once the options have not changed for a short moment
+void SLeartesRenameWidget::ScheduleLivePreview()
+{
+    if (!GEditor)
+    {
+        RefreshPreview();
+        return;
+    }
+
+    // setting a pending timer again restarts it
+    GEditor->GetTimerManager()->SetTimer(LivePreviewTimer, FTimerDelegate::CreateSP(this, &SLeartesRenameWidget::RefreshPreview), LivePreviewDelay, false);
+}
+
+//slots of a freshly compacted list, every item is where the next preview stage will have it
+static void ResetSlotOrigins(TArray<int32>& Origins, int32 Num)
+{
+    Origins.SetNumUninitialized(Num);
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Origins[i] = i;
+    }
+}
+
+//read the whole selection again, the change events keep it current afterwards
 void SLeartesRenameWidget::RefreshSelection()
 {
     //assets in content browser
-    CachedSelectedAssets.Empty();
+    CachedSelectedAssets.Reset();
+    SelectedAssetSlots.Reset();
+    AssetSlotOrigins.Reset();
     if (FModuleManager::Get().IsModuleLoaded("ContentBrowser"))
     {
         FContentBrowserModule& CBModule = FModuleManager::LoadModuleChecked<FContentBrowserModule>("ContentBrowser");
         TArray<FAssetData> SelectedAssets;
         CBModule.Get().GetSelectedAssets(SelectedAssets);
-        CachedSelectedAssets = SelectedAssets;
+        for (const FAssetData& Asset : SelectedAssets)
+        {
+            AddSelectedAsset(Asset);
+        }
     }
 
     //actors in level editor
-    CachedSelectedActors.Empty();
+    CachedSelectedActors.Reset();
+    SelectedActorSlots.Reset();
+    ActorSlotOrigins.Reset();
     if (GEditor)
     {
         USelection* SelectedActors = GEditor->GetSelectedActors();
         for (FSelectionIterator It(*SelectedActors); It; ++It)
         {
-            AActor* Actor = Cast<AActor>(*It);
-            if (Actor) CachedSelectedActors.Add(Actor);
+            AddSelectedActor(Cast<AActor>(*It));
+        }
+    }
+
+    // cached previews were built for the old item lists
+    PreviewCache.Reset();
+    ResetSlotOrigins(AssetSlotOrigins, CachedSelectedAssets.Num());
+    ResetSlotOrigins(ActorSlotOrigins, CachedSelectedActors.Num());
+    bAssetSlotsChanged = false;
+    bActorSlotsChanged = false;
+
+    UpdateSelectionCounts();
+}
+
+bool SLeartesRenameWidget::AddSelectedAsset(const FAssetData& Asset)
+{
+    const FSoftObjectPath Path = Asset.GetSoftObjectPath();
+    if (!Asset.IsValid() || SelectedAssetSlots.Contains(Path)) return false;
+
+    SelectedAssetSlots.Add(Path, CachedSelectedAssets.Add(Asset));
+    AssetSlotOrigins.Add(INDEX_NONE);
+    bAssetSlotsChanged = true;
+    return true;
+}
+
+bool SLeartesRenameWidget::AddSelectedActor(AActor* Actor)
+{
+    if (!Actor || SelectedActorSlots.Contains(Actor)) return false;
+
+    SelectedActorSlots.Add(Actor, CachedSelectedActors.Add(Actor));
+    ActorSlotOrigins.Add(INDEX_NONE);
+    bActorSlotsChanged = true;
+    return true;
+}
+
+//the browser hands over its whole selection, only the difference to the cached one is applied
+void SLeartesRenameWidget::OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser)
+{
+    if (!bIsPrimaryBrowser) return;
+
+    bool bChanged = false;
+    for (const FAssetData& Asset : NewSelectedAssets)
+    {
+        bChanged |= AddSelectedAsset(Asset);
+    }
+
+    // with nothing left out, every cached asset is still selected and the removal pass is skipped
+    if (SelectedAssetSlots.Num() > NewSelectedAssets.Num())
+    {
+        TSet<FSoftObjectPath> Selected;
+        Selected.Reserve(NewSelectedAssets.Num());
+        for (const FAssetData& Asset : NewSelectedAssets)
+        {
+            Selected.Add(Asset.GetSoftObjectPath());
+        }
+        for (auto It = SelectedAssetSlots.CreateIterator(); It; ++It)
+        {
+            if (!Selected.Contains(It.Key()))
+            {
+                CachedSelectedAssets[It.Value()] = FAssetData();
+                It.RemoveCurrent();
+            }
+        }
+        bAssetSlotsChanged = true;
+        bChanged = true;
+    }
+
+    if (bChanged)
+    {
+        OnSelectionDelta();
+    }
+}
+
+//fired once per object for both selecting and deselecting, also by the component and object selections
+void SLeartesRenameWidget::OnActorSelectObject(UObject* Object)
+{
+    AActor* Actor = Cast<AActor>(Object);
+    if (!Actor || !GEditor) return;
+
+    if (GEditor->GetSelectedActors()->IsSelected(Actor))
+    {
+        if (AddSelectedActor(Actor))
+        {
+            OnSelectionDelta();
         }
     }
+    else if (const int32* Slot = SelectedActorSlots.Find(Actor))
+    {
+        CachedSelectedActors[*Slot] = nullptr;
+        SelectedActorSlots.Remove(Actor);
+        bActorSlotsChanged = true;
+        OnSelectionDelta();
+    }
+}
 
+//shared by every selection set, only a cleared actor selection matters here
+void SLeartesRenameWidget::OnActorSelectNone()
+{
+    if (SelectedActorSlots.Num() == 0 || !GEditor || GEditor->GetSelectedActors()->Num() > 0) return;
+
+    CachedSelectedActors.Reset();
+    SelectedActorSlots.Reset();
+    ActorSlotOrigins.Reset();
+    bActorSlotsChanged = true;
+    OnSelectionDelta();
+}
+
+//batch selections (marquee, select all, outliner ranges) skip the per object event and only report the end
+//of the batch, so the whole actor selection is diffed against the cached one like the content browser's
+void SLeartesRenameWidget::OnActorSelectionChanged(UObject* Selection)
+{
+    if (!GEditor || Selection != GEditor->GetSelectedActors()) return;
+
+    USelection* SelectedActors = GEditor->GetSelectedActors();
+    bool bChanged = false;
+    int32 NumSelected = 0;
+    for (FSelectionIterator It(*SelectedActors); It; ++It)
+    {
+        if (AActor* Actor = Cast<AActor>(*It))
+        {
+            bChanged |= AddSelectedActor(Actor);
+            ++NumSelected;
+        }
+    }
+
+    // with nothing left out, every cached actor is still selected and the removal pass is skipped
+    if (SelectedActorSlots.Num() > NumSelected)
+    {
+        for (auto It = SelectedActorSlots.CreateIterator(); It; ++It)
+        {
+            const AActor* Actor = CachedSelectedActors[It.Value()];
+            if (!Actor || !SelectedActors->IsSelected(Actor))
+            {
+                CachedSelectedActors[It.Value()] = nullptr;
+                It.RemoveCurrent();
+            }
+        }
+        bActorSlotsChanged = true;
+        bChanged = true;
+    }
+
+    if (bChanged)
+    {
+        OnSelectionDelta();
+    }
+}
+
+//a batch of selection events ends up as one preview after the live preview delay
+void SLeartesRenameWidget::OnSelectionDelta()
+{
     UpdateSelectionCounts();
+    ScheduleLivePreview();
+}
+
+//close the gaps left by removed items and carry the cached preview stages over to the new item order
+void SLeartesRenameWidget::CompactSelection()
+{
+    auto Compact = [this](auto& Items, auto& Slots, TArray<int32>& Origins, ERenameItemKind Kind, auto GetKey)
+    {
+        TArray<int32> OldIndices;
+        OldIndices.Reserve(Slots.Num());
+        int32 Write = 0;
+        for (int32 Slot = 0; Slot < Items.Num(); ++Slot)
+        {
+            const auto Key = GetKey(Items[Slot]);
+            if (!Slots.Contains(Key)) continue;
+
+            OldIndices.Add(Origins[Slot]);
+            if (Write != Slot)
+            {
+                Items[Write] = MoveTemp(Items[Slot]);
+                Slots.FindChecked(Key) = Write;
+            }
+            ++Write;
+        }
+        Items.SetNum(Write);
+        ResetSlotOrigins(Origins, Write);
+        PreviewCache.RemapItems(Kind, OldIndices);
+    };
+
+    if (bAssetSlotsChanged)
+    {
+        Compact(CachedSelectedAssets, SelectedAssetSlots, AssetSlotOrigins, ERenameItemKind::Asset, [](const FAssetData& Asset) { return Asset.GetSoftObjectPath(); });
+        bAssetSlotsChanged = false;
+    }
+    if (bActorSlotsChanged)
+    {
+        Compact(CachedSelectedActors, SelectedActorSlots, ActorSlotOrigins, ERenameItemKind::Actor, [](AActor* Actor) { return TObjectKey<AActor>(Actor); });
+        bActorSlotsChanged = false;
+    }
 }
 
 //Update the text blocks that display how many assets / actors are selected
 void SLeartesRenameWidget::UpdateSelectionCounts()
 {
-    int32 AssetCount = CachedSelectedAssets.Num();
-    int32 ActorCount = CachedSelectedActors.Num();
+    int32 AssetCount = SelectedAssetSlots.Num();
+    int32 ActorCount = SelectedActorSlots.Num();
 
     if (AssetsCountText.IsValid())
     {
@@ -324,17 +845,18 @@ void SLeartesRenameWidget::UpdateSelectionCounts()
         ActorsCountText->SetText(FText::FromString(FString::Printf(TEXT("Actors: %d"), ActorCount)));
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Selected Assets: %d, Selected Actors: %d"), AssetCount, ActorCount);
+    UE_LOG(LogTemp, Verbose, TEXT("Selected Assets: %d, Selected Actors: %d"), AssetCount, ActorCount);
 }
 
-//Build the preview items using FRenameLogic dry-run functions
-void SLeartesRenameWidget::RefreshPreview()
+//read the current option values from the ui into CurrentOptions
+void SLeartesRenameWidget::UpdateOptionsFromUI()
 {
     // Read ui text inputs
     CurrentOptions.Prefix = PrefixTextBox.IsValid() ? PrefixTextBox->GetText().ToString() : TEXT("");
     CurrentOptions.Suffix = SuffixTextBox.IsValid() ? SuffixTextBox->GetText().ToString() : TEXT("");
     CurrentOptions.Find = FindTextBox.IsValid() ? FindTextBox->GetText().ToString() : TEXT("");
     CurrentOptions.Replace = ReplaceTextBox.IsValid() ? ReplaceTextBox->GetText().ToString() : TEXT("");
+    CurrentOptions.ReplaceRules = ReplaceRulesTextBox.IsValid() ? ParseReplaceRules(ReplaceRulesTextBox->GetText().ToString()) : TArray<FRenameReplaceRule>();
 
     // Use cached numeric values and numbering toggle
     if (UseNumberingCheckBox.IsValid())
@@ -358,6 +880,10 @@ void SLeartesRenameWidget::RefreshPreview()
         if (CaseSel.Equals(TEXT("UPPERCASE"))) CurrentOptions.CaseOp = ECaseOp::Upper;
         else if (CaseSel.Equals(TEXT("lowercase"))) CurrentOptions.CaseOp = ECaseOp::Lower;
         else if (CaseSel.Equals(TEXT("CapitalizeFirst"))) CurrentOptions.CaseOp = ECaseOp::CapitalizeFirst;
+        else if (CaseSel.Equals(TEXT("PascalCase"))) CurrentOptions.CaseOp = ECaseOp::PascalCase;
+        else if (CaseSel.Equals(TEXT("snake_case"))) CurrentOptions.CaseOp = ECaseOp::SnakeCase;
+        else if (CaseSel.Equals(TEXT("camelCase"))) CurrentOptions.CaseOp = ECaseOp::CamelCase;
+        else if (CaseSel.Equals(TEXT("Title_Case"))) CurrentOptions.CaseOp = ECaseOp::TitleCase;
         else CurrentOptions.CaseOp = ECaseOp::None;
     }
     else
@@ -368,28 +894,208 @@ void SLeartesRenameWidget::RefreshPreview()
     CurrentOptions.bApplyToAssets = AssetsCheckBox.IsValid() && AssetsCheckBox->IsChecked();
     CurrentOptions.bApplyToActors = ActorsCheckBox.IsValid() && ActorsCheckBox->IsChecked();
     CurrentOptions.bDryRun = DryRunCheckBox.IsValid() && DryRunCheckBox->IsChecked();
+    CurrentOptions.bFixupRedirectors = FixupRedirectorsCheckBox.IsValid() && FixupRedirectorsCheckBox->IsChecked();
+    CurrentOptions.bSaveOnApply = SaveOnApplyCheckBox.IsValid() && SaveOnApplyCheckBox->IsChecked();
+    CurrentOptions.bResolveDuplicates = ResolveDuplicatesCheckBox.IsValid() && ResolveDuplicatesCheckBox->IsChecked();
+    CurrentOptions.bFindRegex = RegexCheckBox.IsValid() && RegexCheckBox->IsChecked();
+    CurrentOptions.bFindIgnoreCase = IgnoreCaseCheckBox.IsValid() && IgnoreCaseCheckBox->IsChecked();
+}
+
+//Build the preview items in the background, rows stream into the list as they are ready
+void SLeartesRenameWidget::RefreshPreview()
+{
+    UpdateOptionsFromUI();
+
+    if (GEditor)
+    {
+        GEditor->GetTimerManager()->ClearTimer(LivePreviewTimer);
+    }
+
+    // a newer preview always replaces the running one
+    CancelPreviewJob();
+    CompactSelection();
+
+    FRenameOptions JobOptions = CurrentOptions;
+    JobOptions.bApplyToAssets = CurrentOptions.bApplyToAssets && CachedSelectedAssets.Num() > 0;
+    JobOptions.bApplyToActors = CurrentOptions.bApplyToActors && CachedSelectedActors.Num() > 0;
+
+    // nothing to compute, or an option set that was previewed recently
+    const FRenamePreviewRows* CachedRows = PreviewCache.FindRows(JobOptions);
+    if (CachedRows || (!JobOptions.bApplyToAssets && !JobOptions.bApplyToActors))
+    {
+        PreviewRows.Reset();
+        if (CachedRows)
+        {
+            PreviewRows.Append(*CachedRows);
+        }
+        ++PreviewRowsSerial;
+        PreviewDiffTexts.Reset();
+        PreviewView.Invalidate();
+        RebuildPreviewItems();
+        bReplacePreviewRows = false;
+        if (PreviewListView.IsValid())
+        {
+            PreviewListView->RequestListRefresh();
+        }
+        return;
+    }
+
+    // the current rows stay visible until the new job has its first rows, so typing does not flicker
+    bReplacePreviewRows = true;
+    PreviewJob = FRenamePreviewJob::Launch(CachedSelectedAssets, CachedSelectedActors, JobOptions, PreviewCache, PreviewGeneration);
+
+    if (!PreviewPollTimer.IsValid())
+    {
+        PreviewPollTimer = RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SLeartesRenameWidget::PollPreviewJob));
+    }
+}
+
+//the old job keeps running on its own references until it sees the new generation
+//it is kept until its worker has returned, so the destructor can wait for every job still reading the indexes
+void SLeartesRenameWidget::CancelPreviewJob()
+{
+    PreviewGeneration->Increment();
+    CancelledPreviewJobs.RemoveAll([](const TSharedPtr<FRenamePreviewJob, ESPMode::ThreadSafe>& Job) { return !Job->IsRunning(); });
+    if (PreviewJob.IsValid())
+    {
+        CancelledPreviewJobs.Add(MoveTemp(PreviewJob));
+    }
+}
+
+//move rows published by the background job into the list, once per frame while it runs
+EActiveTimerReturnType SLeartesRenameWidget::PollPreviewJob(double InCurrentTime, float InDeltaTime)
+{
+    if (!PreviewJob.IsValid())
+    {
+        PreviewPollTimer.Reset();
+        return EActiveTimerReturnType::Stop;
+    }
 
-    // rebuild preview items
-    PreviewItems.Empty();
+    IncomingPreviewRows.Reset();
+    TArray<FRenamePreviewPatch> Patches;
+    const bool bFinished = PreviewJob->ConsumeResults(IncomingPreviewRows, Patches);
 
-    if (CurrentOptions.bApplyToAssets && CachedSelectedAssets.Num() > 0)
+    const bool bRowsChanged = IncomingPreviewRows.Num() > 0 || (bReplacePreviewRows && bFinished);
+    const bool bRowsReplaced = bReplacePreviewRows && bRowsChanged;
+    if (bRowsReplaced)
     {
-        TArray<FRenamePreviewItem> AssetPreview = FRenameLogic::GeneratePreviewForAssets(CachedSelectedAssets, CurrentOptions);
-        for (const FRenamePreviewItem& It : AssetPreview)
+        PreviewRows.Reset();
+        bReplacePreviewRows = false;
+    }
+    const int32 FirstNewRow = PreviewRows.Num();
+    PreviewRows.Append(IncomingPreviewRows);
+
+    // duplicate flags and resolved names arrive last, once every row is in the list
+    for (const FRenamePreviewPatch& Patch : Patches)
+    {
+        PreviewRows.SetBatchDuplicate(Patch.Row, Patch.bBatchDuplicate);
+        if (Patch.bResolved)
         {
-            PreviewItems.Add(MakeShared<FRenamePreviewItem>(It));
+            PreviewRows.SetNewName(Patch.Row, Patch.NewName);
+            PreviewRows.SetCollision(Patch.Row, false);
+            PreviewDiffTexts.Remove(Patch.Row);
         }
     }
 
-    if (CurrentOptions.bApplyToActors && CachedSelectedActors.Num() > 0)
+    // rows arriving while the list is sorted are shown at the end, the list is sorted again once the last rows are in
+    const bool bSorted = PreviewSortColumn != ERenamePreviewColumn::None;
+    if (bRowsReplaced || Patches.Num() > 0 || (bFinished && bSorted))
+    {
+        if (bRowsReplaced)
+        {
+            ++PreviewRowsSerial;
+            PreviewDiffTexts.Reset();
+        }
+        PreviewView.Invalidate();
+        RebuildPreviewItems();
+    }
+    else
+    {
+        AppendPreviewItems(FirstNewRow);
+    }
+
+    if (PreviewListView.IsValid())
     {
-        TArray<FRenamePreviewItem> ActorPreview = FRenameLogic::GeneratePreviewForActors(CachedSelectedActors, CurrentOptions);
-        for (const FRenamePreviewItem& It : ActorPreview)
+        // patched rows already have widgets, those have to be regenerated to show the new text
+        if (Patches.Num() > 0)
+        {
+            PreviewListView->RebuildList();
+        }
+        else if (bRowsChanged || (bFinished && bSorted))
         {
-            PreviewItems.Add(MakeShared<FRenamePreviewItem>(It));
+            PreviewListView->RequestListRefresh();
         }
     }
 
+    if (bFinished)
+    {
+        PreviewCache.Store(*PreviewJob, PreviewRows);
+        PreviewJob.Reset();
+        PreviewPollTimer.Reset();
+        return EActiveTimerReturnType::Stop;
+    }
+    return EActiveTimerReturnType::Continue;
+}
+
+//list handles for every row that passes the filter, in the order of the sort column
+//a replaced arena gets a new serial first, so none of its rows reuse a widget of the old preview
+void SLeartesRenameWidget::RebuildPreviewItems()
+{
+    PreviewView.Build(PreviewRows, PreviewSortColumn, bPreviewSortDescending, bPreviewProblemsOnly, PreviewOrder);
+
+    PreviewItems.Reset(PreviewOrder.Num());
+    for (int32 Row : PreviewOrder)
+    {
+        PreviewItems.Emplace(PreviewRowsSerial, Row);
+    }
+    UpdatePreviewCountText();
+}
+
+//handles for rows appended since the last call, added at the end whatever the sort column
+void SLeartesRenameWidget::AppendPreviewItems(int32 FirstRow)
+{
+    for (int32 Row = FirstRow; Row < PreviewRows.Num(); ++Row)
+    {
+        if (FRenamePreviewView::PassesFilter(PreviewRows, Row, bPreviewProblemsOnly))
+        {
+            PreviewItems.Emplace(PreviewRowsSerial, Row);
+        }
+    }
+    UpdatePreviewCountText();
+}
+
+void SLeartesRenameWidget::UpdatePreviewCountText()
+{
+    if (PreviewCountText.IsValid())
+    {
+        PreviewCountText->SetText(FText::FromString(bPreviewProblemsOnly
+            ? FString::Printf(TEXT("%d of %d rows"), PreviewItems.Num(), PreviewRows.Num())
+            : FString::Printf(TEXT("%d rows"), PreviewRows.Num())));
+    }
+}
+
+EColumnSortMode::Type SLeartesRenameWidget::GetPreviewSortMode(ERenamePreviewColumn Column) const
+{
+    if (PreviewSortColumn != Column) return EColumnSortMode::None;
+    return bPreviewSortDescending ? EColumnSortMode::Descending : EColumnSortMode::Ascending;
+}
+
+//the header toggles between ascending and descending, the rows and their widgets stay the same
+void SLeartesRenameWidget::OnPreviewSortChanged(EColumnSortPriority::Type Priority, const FName& ColumnId, EColumnSortMode::Type NewSortMode)
+{
+    PreviewSortColumn = PreviewColumns::ToViewColumn(ColumnId);
+    bPreviewSortDescending = NewSortMode == EColumnSortMode::Descending;
+    RebuildPreviewItems();
+    if (PreviewListView.IsValid())
+    {
+        PreviewListView->RequestListRefresh();
+    }
+}
+
+void SLeartesRenameWidget::OnProblemsOnlyChanged(ECheckBoxState NewState)
+{
+    bPreviewProblemsOnly = NewState == ECheckBoxState::Checked;
+    RebuildPreviewItems();
     if (PreviewListView.IsValid())
     {
         PreviewListView->RequestListRefresh();
@@ -397,13 +1103,30 @@ void SLeartesRenameWidget::RefreshPreview()
 }
 
 //generate a row for the preview list view
-TSharedRef<ITableRow> SLeartesRenameWidget::OnGenerateRowForPreview(TSharedPtr<FRenamePreviewItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedRef<ITableRow> SLeartesRenameWidget::OnGenerateRowForPreview(FRenamePreviewRowHandle Item, const TSharedRef<STableViewBase>& OwnerTable)
 {
-    FText RowText = FText::FromString(Item->OldName + TEXT(" -> ") + Item->NewName + (Item->bCollision ? TEXT(" (Collision)") : TEXT("")));
-    return SNew(STableRow<TSharedPtr<FRenamePreviewItem>>, OwnerTable)
-    [
-        SNew(STextBlock).Text(RowText)
-    ];
+    return SNew(SRenamePreviewRow, OwnerTable, PreviewRows, Item.Row, GetPreviewDiffTexts(Item.Row));
+}
+
+//diff texts of a row, computed the first time the row comes into view and kept until the rows change
+const TPair<FText, FText>& SLeartesRenameWidget::GetPreviewDiffTexts(int32 Row)
+{
+    if (const TPair<FText, FText>* Cached = PreviewDiffTexts.Find(Row))
+    {
+        return *Cached;
+    }
+
+    // scrolling through a large preview would otherwise end up with a diff for every row passed
+    if (PreviewDiffTexts.Num() >= MaxCachedPreviewDiffs)
+    {
+        PreviewDiffTexts.Reset();
+    }
+
+    const FStringView OldName = PreviewRows.GetOldName(Row);
+    const FStringView NewName = PreviewRows.GetNewName(Row);
+    FRenameNameDiff Spans;
+    RenameNameDiff::Compute(OldName, NewName, Spans);
+    return PreviewDiffTexts.Add(Row, TPair<FText, FText>(MakePreviewDiffText(OldName, Spans, false), MakePreviewDiffText(NewName, Spans, true)));
 }
 
 //refresh button handler
@@ -414,11 +1137,67 @@ FReply SLeartesRenameWidget::OnRefreshClicked()
     return FReply::Handled();
 }
 
+// report what an apply did; saves run with SAVE_NoError and without a source control
+// checkout, so read-only packages fail quietly unless they are surfaced here
+static void NotifyApplyResult(const FRenameBatchResult& AssetResult, const FRenameBatchResult& ActorResult, const FRenameOptions& Options)
+{
+    const int32 Renamed = AssetResult.SuccessCount + ActorResult.SuccessCount;
+    const int32 Failed = AssetResult.FailureCount + ActorResult.FailureCount;
+
+    TArray<FString> SaveFailures = AssetResult.SaveFailures;
+    SaveFailures.Append(ActorResult.SaveFailures);
+
+    FString Message = FString::Printf(TEXT("Renamed %d item(s)"), Renamed);
+    if (Failed > 0)
+    {
+        Message += FString::Printf(TEXT(", %d failed"), Failed);
+    }
+    if (Options.bSaveOnApply || Options.bFixupRedirectors)
+    {
+        Message += FString::Printf(TEXT("\nSaved %d package(s)"), AssetResult.SavedPackages + ActorResult.SavedPackages);
+    }
+    if (Options.bFixupRedirectors && AssetResult.DeletedRedirectors > 0)
+    {
+        Message += FString::Printf(TEXT("\nFixed up %d referencer(s), deleted %d redirector(s) in %.2fs"),
+            AssetResult.FixedUpPackages, AssetResult.DeletedRedirectors, AssetResult.FixupSeconds);
+    }
+
+    if (SaveFailures.Num() > 0)
+    {
+        Message += FString::Printf(TEXT("\n%d package(s) could not be saved, check they are writable or checked out:"), SaveFailures.Num());
+        for (int32 Index = 0; Index < FMath::Min(SaveFailures.Num(), MaxNotifiedSaveFailures); ++Index)
+        {
+            Message += TEXT("\n  ") + SaveFailures[Index];
+        }
+        if (SaveFailures.Num() > MaxNotifiedSaveFailures)
+        {
+            Message += FString::Printf(TEXT("\n  ...and %d more, see the output log"), SaveFailures.Num() - MaxNotifiedSaveFailures);
+        }
+        if (Options.bFixupRedirectors)
+        {
+            Message += TEXT("\nThe redirector fixup was skipped.");
+        }
+    }
+
+    const bool bProblems = Failed > 0 || SaveFailures.Num() > 0;
+
+    FNotificationInfo Info(FText::FromString(Message));
+    Info.bFireAndForget = true;
+    Info.ExpireDuration = bProblems ? 10.0f : 4.0f;
+    Info.bUseLargeFont = false;
+    TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+    if (Notification.IsValid())
+    {
+        Notification->SetCompletionState(bProblems ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+    }
+}
+
 //apply button handler
 FReply SLeartesRenameWidget::OnApplyClicked()
 {
     //refresh options from ui first
-    RefreshPreview();
+    UpdateOptionsFromUI();
+    CompactSelection();
 
     TArray<FAssetData> AssetsToRename;
     TArray<AActor*> ActorsToRename;
@@ -437,13 +1216,19 @@ FReply SLeartesRenameWidget::OnApplyClicked()
 
     if (!CurrentOptions.bDryRun)
     {
+        FRenameBatchResult AssetResult;
+        FRenameBatchResult ActorResult;
         if (AssetsToRename.Num() > 0)
         {
-            FRenameLogic::RenameAssetsBatch(AssetsToRename, CurrentOptions);
+            AssetResult = FRenameLogic::RenameAssetsBatch(AssetsToRename, CurrentOptions);
         }
         if (ActorsToRename.Num() > 0)
         {
-            FRenameLogic::RenameActorsBatch(ActorsToRename, CurrentOptions);
+            ActorResult = FRenameLogic::RenameActorsBatch(ActorsToRename, CurrentOptions);
+        }
+        if (AssetsToRename.Num() > 0 || ActorsToRename.Num() > 0)
+        {
+            NotifyApplyResult(AssetResult, ActorResult, CurrentOptions);
         }
 
         // update content browser selection to renamed assets
@@ -474,6 +1259,7 @@ FReply SLeartesRenameWidget::OnCancelClicked()
     if (SuffixTextBox.IsValid()) SuffixTextBox->SetText(FText::GetEmpty());
     if (FindTextBox.IsValid()) FindTextBox->SetText(FText::GetEmpty());
     if (ReplaceTextBox.IsValid()) ReplaceTextBox->SetText(FText::GetEmpty());
+    if (ReplaceRulesTextBox.IsValid()) ReplaceRulesTextBox->SetText(FText::GetEmpty());
 
     // Reset cached numeric values and case selection
     CachedStartNumber = 1;
@@ -492,8 +1278,7 @@ FReply SLeartesRenameWidget::OnCancelClicked()
         UseNumberingCheckBox->SetIsChecked(ECheckBoxState::Checked);
     }
 
-    // refresh selection counts and preview
-    RefreshSelection();
+    // the selection itself is unchanged and still tracked
     RefreshPreview();
 
     return FReply::Handled();
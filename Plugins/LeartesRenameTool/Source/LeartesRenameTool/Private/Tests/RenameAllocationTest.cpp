@@ -0,0 +1,112 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "IAssetTools.h"
+#include "AssetNameIndex.h"
+#include "RenameBenchmarkHelpers.h"
+#include "RenameLogic.h"
+#include "RenameNameReference.h"
+#include "RenameTypes.h"
+
+//allocations per item on the preview and apply paths, run headless with
+//-ExecCmds="Automation RunTests LeartesRenameTool.Allocations"
+//thresholds are the strings each path keeps per item plus a little for the batch's own arrays
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RenameAllocationTest
+{
+	static const TCHAR* Root = TEXT("/Game/__LeartesRenameAllocationTest");
+	static constexpr int32 Count = 10000;
+
+	// the planned name
+	static constexpr double MaxPlanPerItem = 1.1;
+	// the row's old and new name
+	static constexpr double MaxPreviewPerItem = 2.1;
+	// the planned name, which moves into the rename data, the result's old and new package names and the
+	// rename data's package path
+	static constexpr double MaxApplyPlanPerItem = 4.1;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLeartesRenameAllocationTest, "LeartesRenameTool.Allocations",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLeartesRenameAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace RenameAllocationTest;
+	using namespace RenameBenchmarks;
+
+#if !MALLOC_GT_HOOKS
+	AddInfo(TEXT("This build has no game thread malloc hook, allocations cannot be counted"));
+	return true;
+#else
+	const FString PackagePath = FString(Root) / TEXT("Assets");
+	const TArray<FAssetData> Assets = CreateTransientAssets(MakeNameCorpus(Count), PackagePath);
+	ON_SCOPE_EXIT { DestroyTransientAssets(Root); };
+
+	FRenameOptions Options;
+	Options.Prefix = TEXT("P_");
+	Options.Suffix = TEXT("_S");
+	Options.Find = TEXT("_");
+	Options.Replace = TEXT("-");
+	Options.CaseOp = ECaseOp::Upper;
+	// the hook only sees the game thread, worker chunks would go uncounted
+	Options.bParallelPreview = false;
+
+	// the one time snapshot of the path is not per item work
+	FAssetNameIndex::Get().EnsurePath(FName(*PackagePath));
+
+	// per item log lines land in the output log history, which allocates
+	const ELogVerbosity::Type Verbosity = LogTemp.GetVerbosity();
+	LogTemp.SetVerbosity(ELogVerbosity::Warning);
+	ON_SCOPE_EXIT { LogTemp.SetVerbosity(Verbosity); };
+
+	// legacy path, fresh strings for every intermediate step, for reference only
+	int64 LegacyAllocations = 0;
+	int64 Checksum = 0;
+	{
+		FScopedAllocationCounter Counter;
+		for (int32 i = 0; i < Assets.Num(); ++i)
+		{
+			Checksum += RenameNameReference::GenerateNewName(Assets[i].AssetName.ToString(), Options, i).Len();
+		}
+		LegacyAllocations = Counter.Get();
+	}
+
+	int64 PlanAllocations = 0;
+	{
+		TBitArray<> Duplicates;
+		FScopedAllocationCounter Counter;
+		TArray<FString> Planned = FRenameLogic::PlanAssetNames(Assets, Options, Duplicates);
+		PlanAllocations = Counter.Get();
+	}
+
+	int64 PreviewAllocations = 0;
+	{
+		FScopedAllocationCounter Counter;
+		TArray<FRenamePreviewItem> Preview = FRenameLogic::GeneratePreviewForAssets(Assets, Options);
+		PreviewAllocations = Counter.Get();
+	}
+
+	int64 ApplyPlanAllocations = 0;
+	{
+		FRenameBatchResult Result;
+		TArray<FAssetRenameData> RenameData;
+		TArray<int32> ResultIndices;
+		FScopedAllocationCounter Counter;
+		FRenameLogic::PlanAssetRenames(Assets, Options, Result, RenameData, ResultIndices);
+		ApplyPlanAllocations = Counter.Get();
+		TestEqual(TEXT("Every asset is planned"), RenameData.Num(), Assets.Num());
+	}
+
+	const double PerItem = 1.0 / Assets.Num();
+	AddInfo(FString::Printf(TEXT("Allocations per item over %d assets: legacy name %.2f, planned name %.2f, preview row %.2f, apply plan %.2f (checksum %lld)"),
+		Assets.Num(), LegacyAllocations * PerItem, PlanAllocations * PerItem, PreviewAllocations * PerItem, ApplyPlanAllocations * PerItem, Checksum));
+
+	TestTrue(FString::Printf(TEXT("Planned names allocate at most %.1f per item"), MaxPlanPerItem), PlanAllocations * PerItem <= MaxPlanPerItem);
+	TestTrue(FString::Printf(TEXT("Preview rows allocate at most %.1f per item"), MaxPreviewPerItem), PreviewAllocations * PerItem <= MaxPreviewPerItem);
+	TestTrue(FString::Printf(TEXT("Apply planning allocates at most %.1f per item"), MaxApplyPlanPerItem), ApplyPlanAllocations * PerItem <= MaxApplyPlanPerItem);
+	return true;
+#endif
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "RenameBenchmarkHelpers.h"
+#include "RenameLogic.h"
+#include "RenameTypes.h"
+
+//undo and redo of an actor batch rename restore both the labels and the object names
+//actors live in a scratch world and the transaction in a scratch buffer, the user's level and undo history stay untouched
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLeartesRenameLabelUndoTest, "LeartesRenameTool.LabelUndo",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLeartesRenameLabelUndoTest::RunTest(const FString& Parameters)
+{
+	using namespace RenameBenchmarks;
+
+	if (!GEditor || GEditor->IsTransactionActive())
+	{
+		AddError(TEXT("The label undo test needs the editor with no transaction open"));
+		return false;
+	}
+
+	UWorld* World = CreateScratchWorld(TEXT("LeartesRenameLabelUndoTest"));
+	ON_SCOPE_EXIT { DestroyScratchWorld(World); };
+
+	const TArray<AActor*> Actors = SpawnLabeledActors(World, { TEXT("Crate"), TEXT("Barrel"), TEXT("Crate_Small"), TEXT("Lamp") });
+
+	// left before the world goes away, the undo record references its actors
+	FScopedScratchTransactor ScratchTransactor;
+
+	TArray<FString> OldLabels;
+	TArray<FName> OldNames;
+	for (const AActor* Actor : Actors)
+	{
+		OldLabels.Add(Actor->GetActorLabel());
+		OldNames.Add(Actor->GetFName());
+	}
+
+	FRenameOptions Options;
+	Options.Prefix = TEXT("Renamed_");
+	Options.bDryRun = false;
+	const FRenameBatchResult Result = FRenameLogic::RenameActorsBatch(Actors, Options);
+	TestEqual(TEXT("Actors renamed"), Result.SuccessCount, Actors.Num());
+
+	TArray<FString> NewLabels;
+	TArray<FName> NewNames;
+	bool bAnyNameChanged = false;
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		NewLabels.Add(Actors[i]->GetActorLabel());
+		NewNames.Add(Actors[i]->GetFName());
+		TestNotEqual(TEXT("Label changed by the rename"), NewLabels[i], OldLabels[i]);
+		bAnyNameChanged |= NewNames[i] != OldNames[i];
+	}
+	if (!bAnyNameChanged)
+	{
+		AddInfo(TEXT("SetActorLabel kept every object name, only the labels are exercised"));
+	}
+
+	if (!TestTrue(TEXT("Rename is undone"), GEditor->UndoTransaction()))
+	{
+		return false;
+	}
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		TestEqual(TEXT("Label after undo"), Actors[i]->GetActorLabel(), OldLabels[i]);
+		TestTrue(TEXT("Name after undo"), Actors[i]->GetFName() == OldNames[i]);
+	}
+
+	if (!TestTrue(TEXT("Rename is redone"), GEditor->RedoTransaction()))
+	{
+		return false;
+	}
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		TestEqual(TEXT("Label after redo"), Actors[i]->GetActorLabel(), NewLabels[i]);
+		TestTrue(TEXT("Name after redo"), Actors[i]->GetFName() == NewNames[i]);
+	}
+	return true;
+}
+
+#endif
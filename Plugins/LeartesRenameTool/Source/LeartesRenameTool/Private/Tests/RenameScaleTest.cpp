@@ -0,0 +1,301 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "ActorLabelIndex.h"
+#include "AssetNameIndex.h"
+#include "RenameBenchmarkHelpers.h"
+#include "RenameLogic.h"
+#include "RenameTypes.h"
+
+//index, preview, collision checks, apply and undo of synthetic assets and actors at 1k, 10k and 100k items
+//each run writes a json report to Saved/LeartesRename for regression tracking, e.g. on a headless linux editor:
+//UnrealEditor-Cmd Project.uproject -unattended -nullrhi -ExecCmds="Automation RunTests LeartesRenameTool.Scale; Quit"
+//actors live in a scratch world and transactions in a scratch buffer, the user's level and undo history stay untouched
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RenameScaleTest
+{
+	static const TCHAR* Root = TEXT("/Game/__LeartesRenameScaleTest");
+
+	// times one phase in milliseconds and records it in the run object
+	struct FPhaseTimer
+	{
+		TSharedRef<FJsonObject> Phases = MakeShared<FJsonObject>();
+
+		void Time(const TCHAR* Phase, TFunctionRef<void()> Body)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Body();
+			Phases->SetNumberField(Phase, (FPlatformTime::Seconds() - Start) * 1000.0);
+		}
+	};
+
+	// undo the rename if it is the newest transaction, false if the batch left none
+	static bool TimeRenameUndo(FPhaseTimer& Timer, const TCHAR* TransactionTitle)
+	{
+		UTransactor* Trans = GEditor->Trans;
+		if (!Trans->CanUndo() || Trans->GetUndoContext().Title.ToString() != TransactionTitle)
+		{
+			return false;
+		}
+		Timer.Time(TEXT("undo"), []() { GEditor->UndoTransaction(); });
+		return true;
+	}
+
+	static FRenameOptions MakeOptions()
+	{
+		FRenameOptions Options;
+		Options.Prefix = TEXT("B_");
+		Options.Suffix = TEXT("_S");
+		Options.Find = TEXT("_");
+		Options.Replace = TEXT("-");
+		Options.bUseNumbering = true;
+		Options.Padding = 6;
+		Options.bDryRun = false;
+		return Options;
+	}
+
+	static TSharedRef<FJsonObject> MakeRun(const TCHAR* Kind, int32 Count, int32 Collisions, const FRenameBatchResult& Result, const FPhaseTimer& Timer)
+	{
+		TSharedRef<FJsonObject> Run = MakeShared<FJsonObject>();
+		Run->SetStringField(TEXT("kind"), Kind);
+		Run->SetNumberField(TEXT("count"), Count);
+		Run->SetNumberField(TEXT("collisions"), Collisions);
+		Run->SetNumberField(TEXT("renamed"), Result.SuccessCount);
+		Run->SetNumberField(TEXT("failed"), Result.FailureCount);
+		Run->SetObjectField(TEXT("phases_ms"), Timer.Phases);
+		return Run;
+	}
+
+	static TSharedRef<FJsonObject> RunAssets(FAutomationTestBase& Test, int32 Count)
+	{
+		using namespace RenameBenchmarks;
+
+		const FString PackagePath = FString::Printf(TEXT("%s/Scale%d"), Root, Count);
+		const TArray<FAssetData> Assets = CreateTransientAssets(MakeNameCorpus(Count), PackagePath);
+		ON_SCOPE_EXIT { DestroyTransientAssets(Root); };
+
+		// left before the assets go away, the transactions may reference them
+		FScopedScratchTransactor ScratchTransactor;
+
+		TArray<TWeakObjectPtr<UObject>> Objects;
+		Objects.Reserve(Assets.Num());
+		for (const FAssetData& AD : Assets)
+		{
+			Objects.Add(AD.FastGetAsset(false));
+		}
+
+		const FRenameOptions Options = MakeOptions();
+		FPhaseTimer Timer;
+		FAssetNameIndex& NameIndex = FAssetNameIndex::Get();
+
+		// cold snapshot of the target path, then the lookups alone against the warm index
+		Timer.Time(TEXT("index"), [&NameIndex, &PackagePath]()
+		{
+			NameIndex.Invalidate();
+			NameIndex.EnsurePath(FName(*PackagePath));
+		});
+
+		TArray<FRenamePreviewItem> Preview;
+		Timer.Time(TEXT("preview"), [&Preview, &Assets, &Options]() { Preview = FRenameLogic::GeneratePreviewForAssets(Assets, Options); });
+
+		int32 Collisions = 0;
+		Timer.Time(TEXT("collisions"), [&Collisions, &Preview, &NameIndex, &PackagePath]()
+		{
+			const FName Path(*PackagePath);
+			for (const FRenamePreviewItem& Item : Preview)
+			{
+				Collisions += NameIndex.DoesPackageExist(Path, Item.NewName) ? 1 : 0;
+			}
+		});
+
+		FRenameBatchResult Result;
+		Timer.Time(TEXT("apply"), [&Result, &Assets, &Options]() { Result = FRenameLogic::RenameAssetsBatch(Assets, Options); });
+
+		Test.TestEqual(TEXT("Assets renamed"), Result.SuccessCount, Count);
+		Test.TestEqual(TEXT("Assets failed"), Result.FailureCount, 0);
+
+		int32 Moved = 0;
+		for (int32 i = 0; i < Objects.Num(); ++i)
+		{
+			const UObject* Asset = Objects[i].Get();
+			Moved += Asset && Asset->GetPackage()->GetName() == PackagePath / Preview[i].NewName ? 1 : 0;
+		}
+		Test.TestEqual(TEXT("Assets in their planned packages"), Moved, Count);
+
+		// AssetTools renames may leave nothing to undo, there is no undo phase then
+		if (TimeRenameUndo(Timer, TEXT("Rename Assets")))
+		{
+			int32 Restored = 0;
+			for (int32 i = 0; i < Objects.Num(); ++i)
+			{
+				const UObject* Asset = Objects[i].Get();
+				Restored += Asset && Asset->GetPackage()->GetFName() == Assets[i].PackageName ? 1 : 0;
+			}
+			Test.TestEqual(TEXT("Assets back in their old packages after undo"), Restored, Count);
+		}
+		else
+		{
+			Test.AddInfo(TEXT("The asset rename left no undoable transaction, asset undo is not timed"));
+		}
+
+		return MakeRun(TEXT("assets"), Count, Collisions, Result, Timer);
+	}
+
+	static TSharedRef<FJsonObject> RunActors(FAutomationTestBase& Test, int32 Count)
+	{
+		using namespace RenameBenchmarks;
+
+		UWorld* World = CreateScratchWorld(TEXT("LeartesRenameScaleTest"));
+		ON_SCOPE_EXIT { DestroyScratchWorld(World); };
+
+		const TArray<AActor*> Actors = SpawnLabeledActors(World, MakeNameCorpus(Count));
+
+		// left before the world goes away, the undo record references its actors
+		FScopedScratchTransactor ScratchTransactor;
+
+		TArray<FString> OldLabels;
+		TArray<FName> OldNames;
+		OldLabels.Reserve(Actors.Num());
+		OldNames.Reserve(Actors.Num());
+		for (const AActor* Actor : Actors)
+		{
+			OldLabels.Add(Actor->GetActorLabel());
+			OldNames.Add(Actor->GetFName());
+		}
+
+		const FRenameOptions Options = MakeOptions();
+		FPhaseTimer Timer;
+		FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+
+		Timer.Time(TEXT("index"), [&LabelIndex, World]()
+		{
+			LabelIndex.Invalidate();
+			LabelIndex.EnsureWorld(World);
+		});
+
+		TArray<FRenamePreviewItem> Preview;
+		Timer.Time(TEXT("preview"), [&Preview, &Actors, &Options]() { Preview = FRenameLogic::GeneratePreviewForActors(Actors, Options); });
+
+		int32 Collisions = 0;
+		Timer.Time(TEXT("collisions"), [&Collisions, &Preview, &Actors, &LabelIndex, World]()
+		{
+			for (int32 i = 0; i < Preview.Num(); ++i)
+			{
+				Collisions += LabelIndex.IsLabelUsed(World, Preview[i].NewName, Actors[i]) ? 1 : 0;
+			}
+		});
+
+		FRenameBatchResult Result;
+		Timer.Time(TEXT("apply"), [&Result, &Actors, &Options]() { Result = FRenameLogic::RenameActorsBatch(Actors, Options); });
+
+		Test.TestEqual(TEXT("Actors renamed"), Result.SuccessCount, Count);
+		Test.TestEqual(TEXT("Actors failed"), Result.FailureCount, 0);
+
+		int32 Relabeled = 0;
+		for (int32 i = 0; i < Actors.Num(); ++i)
+		{
+			Relabeled += Actors[i]->GetActorLabel() == Preview[i].NewName ? 1 : 0;
+		}
+		Test.TestEqual(TEXT("Actors with their planned labels"), Relabeled, Count);
+
+		if (Test.TestTrue(TEXT("Actor rename is undoable"), TimeRenameUndo(Timer, TEXT("Rename Actors"))))
+		{
+			int32 Restored = 0;
+			for (int32 i = 0; i < Actors.Num(); ++i)
+			{
+				Restored += Actors[i]->GetActorLabel() == OldLabels[i] && Actors[i]->GetFName() == OldNames[i] ? 1 : 0;
+			}
+			Test.TestEqual(TEXT("Actors with their old labels and names after undo"), Restored, Count);
+		}
+
+		return MakeRun(TEXT("actors"), Count, Collisions, Result, Timer);
+	}
+
+	static void WriteReport(FAutomationTestBase& Test, int32 Count, const TArray<TSharedRef<FJsonObject>>& Runs)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (const TSharedRef<FJsonObject>& Run : Runs)
+		{
+			const TSharedPtr<FJsonObject>& Phases = Run->GetObjectField(TEXT("phases_ms"));
+			double UndoMs = 0.0;
+			const FString Undo = Phases->TryGetNumberField(TEXT("undo"), UndoMs) ? FString::Printf(TEXT("%.1f ms"), UndoMs) : FString(TEXT("n/a"));
+			Test.AddInfo(FString::Printf(TEXT("%s x %d: index %.1f ms, preview %.1f ms, collisions %.1f ms, apply %.1f ms, undo %s"),
+				*Run->GetStringField(TEXT("kind")), Count,
+				Phases->GetNumberField(TEXT("index")), Phases->GetNumberField(TEXT("preview")), Phases->GetNumberField(TEXT("collisions")),
+				Phases->GetNumberField(TEXT("apply")), *Undo));
+			Values.Add(MakeShared<FJsonValueObject>(Run));
+		}
+
+		TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+		Report->SetStringField(TEXT("engine"), FEngineVersion::Current().ToString());
+		Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+		Report->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+		Report->SetArrayField(TEXT("runs"), Values);
+
+		FString Json;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Report, Writer);
+
+		const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("LeartesRename") / FString::Printf(TEXT("ScaleTest-%d-%s.json"), Count, *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(Json, *ReportPath))
+		{
+			Test.AddInfo(FString::Printf(TEXT("Report written to %s"), *ReportPath));
+		}
+		else
+		{
+			Test.AddError(FString::Printf(TEXT("Could not write the report to %s"), *ReportPath));
+		}
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FLeartesRenameScaleTest, "LeartesRenameTool.Scale",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FLeartesRenameScaleTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (int32 Count : { 1000, 10000, 100000 })
+	{
+		OutBeautifiedNames.Add(FString::Printf(TEXT("%dk"), Count / 1000));
+		OutTestCommands.Add(FString::FromInt(Count));
+	}
+}
+
+bool FLeartesRenameScaleTest::RunTest(const FString& Parameters)
+{
+	using namespace RenameScaleTest;
+
+	int32 Count = 0;
+	if (!LexTryParseString(Count, *Parameters) || Count <= 0)
+	{
+		AddError(FString::Printf(TEXT("Bad item count '%s'"), *Parameters));
+		return false;
+	}
+	if (!GEditor || GEditor->IsTransactionActive())
+	{
+		AddError(TEXT("The scale test needs the editor with no transaction open"));
+		return false;
+	}
+
+	const TArray<TSharedRef<FJsonObject>> Runs = { RunAssets(*this, Count), RunActors(*this, Count) };
+	WriteReport(*this, Count, Runs);
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	return true;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class AActor;
+class ULevel;
+class UWorld;
+
+//hashed index of actor labels per world, used for label collision checks
+//built lazily on first query and kept current through editor actor, label and level events
+//only the game thread writes, worker threads may query indexed worlds through the key overload
+
+class FActorLabelIndex
+{
+public:
+
+	static void Initialize();
+
+	static void Shutdown();
+
+	static FActorLabelIndex& Get();
+
+	// true if any actor in the world other than IgnoreActor uses the label (case sensitive)
+	// indexes the world first when called on the game thread
+	bool IsLabelUsed(UWorld* World, const FString& Label, const AActor* IgnoreActor = nullptr);
+
+	// read only lookup that is safe from any thread, worlds that are not indexed report no collision
+	bool IsLabelUsed(TObjectKey<UWorld> World, const FString& Label, TObjectKey<AActor> IgnoreActor) const;
+
+	// build the index for a world ahead of the first query
+	void EnsureWorld(UWorld* World);
+
+	// drop all indexed worlds, they are rebuilt on the next query
+	void Invalidate();
+
+	// changes whenever an answer of the index may have changed, game thread only
+	uint32 GetVersion() const { return Version; }
+
+	// map key funcs for labels, which are compared case sensitively like the outliner does
+	struct FLabelKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false>
+	{
+		static FORCEINLINE bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+private:
+
+	struct FWorldLabels
+	{
+		// number of actors using each label
+		TMap<FString, int32, FDefaultSetAllocator, FLabelKeyFuncs> LabelCounts;
+		// label each actor was indexed with, needed to undo its count when it changes
+		TMap<TObjectKey<AActor>, FString> ActorLabels;
+	};
+
+	void RegisterDelegates();
+	void UnregisterDelegates();
+
+	FWorldLabels* FindWorldLabels(const AActor* Actor);
+	static void AddActor(FWorldLabels& Labels, AActor* Actor);
+	static void RemoveActor(FWorldLabels& Labels, const AActor* Actor);
+
+	// editor event handlers
+	void OnActorAdded(AActor* Actor);
+	void OnActorDeleted(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+private:
+
+	TMap<TObjectKey<UWorld>, FWorldLabels> Worlds;
+
+	// held for writing by game thread changes, for reading by off game thread lookups
+	mutable FRWLock IndexLock;
+	uint32 Version = 0;
+
+	bool bDelegatesRegistered = false;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle LabelChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle UndoRedoHandle;
+
+	static TUniquePtr<FActorLabelIndex> Instance;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetData;
+
+//in-memory index of existing package names per package path, used for asset collision checks
+//each path is snapshotted from the asset registry once and then kept current through registry events
+//only the game thread writes, worker threads may query snapshotted paths
+
+class FAssetNameIndex
+{
+public:
+
+	static void Initialize();
+
+	static void Shutdown();
+
+	static FAssetNameIndex& Get();
+
+	// true if a package named PackagePath/PackageShortName is already known to the registry
+	// snapshots the path first when called on the game thread, elsewhere paths that are not
+	// snapshotted report no collision
+	bool DoesPackageExist(FName PackagePath, const FString& PackageShortName);
+
+	// snapshot a package path ahead of the first query
+	void EnsurePath(FName PackagePath);
+
+	// drop all snapshots, they are rebuilt on the next query
+	void Invalidate();
+
+	// changes whenever an answer of the index may have changed, game thread only
+	uint32 GetVersion() const { return Version; }
+
+private:
+
+	// short package name -> number of registry assets living in that package
+	using FPackageCounts = TMap<FName, int32>;
+
+	void RegisterDelegates();
+	void UnregisterDelegates();
+
+	void AddPackage(FName PackageName);
+	void RemovePackage(FName PackageName);
+
+	// asset registry event handlers
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+private:
+
+	TMap<FName, FPackageCounts> Paths;
+
+	// held for writing by game thread changes, for reading by off game thread lookups
+	mutable FRWLock IndexLock;
+	uint32 Version = 0;
+
+	bool bDelegatesRegistered = false;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+
+	static TUniquePtr<FAssetNameIndex> Instance;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "LeartesRelabelMapsCommandlet.generated.h"
+
+//relabels the actors of many maps with the rules of a json rules file, see RenameRules.h
+//UnrealEditor-Cmd Project.uproject -run=LeartesRelabelMaps -Maps=Maps.txt -Rules=Rules.json
+//    [-Workers=N] [-MemoryCapMB=4096] [-DryRun] [-Report=Report.json] -unattended -nullrhi
+//
+//the maps file lists one map per line, as a package name or a .umap file, sublevels are maps of their own
+//the coordinator splits the list into one shard per worker process, balanced by file size, and merges
+//the per map reports of the workers. a worker loads, relabels, saves and unloads one map at a time and
+//exits early once it uses more memory than the cap, the coordinator then starts a fresh worker on the rest
+//
+//returns 0 if every map was relabeled and saved, 1 otherwise
+
+UCLASS()
+class ULeartesRelabelMapsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	ULeartesRelabelMapsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	int32 RunCoordinator(const FString& Params);
+
+	// internal mode the coordinator starts its worker processes in
+	int32 RunWorker(const FString& Params);
+};
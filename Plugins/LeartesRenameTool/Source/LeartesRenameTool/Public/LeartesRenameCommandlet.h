@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "LeartesRenameCommandlet.generated.h"
+
+//headless batch rename of assets driven by a json rules file, no Slate and no viewport involved
+//UnrealEditor-Cmd Project.uproject -run=LeartesRename -Rules=Rules.json [-DryRun] [-NoSave] [-Report=Report.json] -unattended -nullrhi
+//the rules file format is described in RenameRules.h, asset rules need at least one content path
+//-NoSave leaves every package unsaved, fixupRedirectors of the rules is turned off then, since it saves
+//
+//returns 0 if every matched asset was renamed, 1 on a bad rules file, a failed rename or a failed save
+
+UCLASS()
+class ULeartesRenameCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	ULeartesRenameCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
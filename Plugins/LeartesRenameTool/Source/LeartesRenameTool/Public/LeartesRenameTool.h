@@ -27,7 +27,12 @@ private:
 	//Create and return the plugin tab widget when requested
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs& SpawnTabArgs);
 
+	//Ask whether to resume or roll back an asset rename batch an earlier session did not finish
+	void OfferJournalRecovery(double Duration);
+
 private:
 	//Command list for UI actions (open window, etc.)
 	TSharedPtr<class FUICommandList> PluginCommands;
+
+	FDelegateHandle EditorInitializedHandle;
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/UnrealMemory.h"
+
+class AActor;
+class UTransactor;
+class UTransBuffer;
+class UWorld;
+
+//synthetic data for the console benchmarks and the automation tests
+//nothing here touches the open level or saves a package
+
+namespace RenameBenchmarks
+{
+	// deterministic asset style names of mixed length, names may repeat
+	TArray<FString> MakeNameCorpus(int32 Count);
+
+	// asset data under a path that does not exist on disk, the assets themselves are never created
+	TArray<FAssetData> MakeSyntheticAssets(const TArray<FString>& Names, FName PackagePath);
+
+	// in-memory curve assets with unique corpus style names under PackagePath, registered but never saved
+	TArray<FAssetData> CreateTransientAssets(const TArray<FString>& Corpus, const FString& PackagePath);
+
+	// drop every in-memory asset and redirector left under RootPath
+	void DestroyTransientAssets(const FString& RootPath);
+
+	// an editor world of its own, so nothing touches the open level
+	UWorld* CreateScratchWorld(const TCHAR* Name);
+	void DestroyScratchWorld(UWorld* World);
+
+	// one plain actor per label
+	TArray<AActor*> SpawnLabeledActors(UWorld* World, const TArray<FString>& Labels);
+
+	// swaps the editor's transaction buffer for an empty one while in scope, so what runs inside can be
+	// undone without touching the user's undo history, must be left before the objects it recorded go away
+	class FScopedScratchTransactor
+	{
+	public:
+		UE_NONCOPYABLE(FScopedScratchTransactor);
+
+		FScopedScratchTransactor();
+		~FScopedScratchTransactor();
+
+	private:
+		UTransactor* Previous = nullptr;
+		UTransBuffer* Scratch = nullptr;
+	};
+
+#if MALLOC_GT_HOOKS
+	// counts the heap allocations the game thread makes while in scope, through the engine's game thread
+	// malloc hook instead of replacing GMalloc, allocations made by other threads are not seen
+	class FScopedAllocationCounter
+	{
+	public:
+		UE_NONCOPYABLE(FScopedAllocationCounter);
+
+		FScopedAllocationCounter();
+		~FScopedAllocationCounter();
+
+		int64 Get() const { return Count; }
+
+	private:
+		TFunction<void(int32)> Hook;
+		TFunction<void(int32)>* PreviousHook = nullptr;
+		int64 Count = 0;
+	};
+#endif
+}
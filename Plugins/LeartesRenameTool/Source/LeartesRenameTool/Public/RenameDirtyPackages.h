@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "RenameTypes.h"
+
+class UPackage;
+
+//packages dirtied by one rename batch, and saving them once the batch is over
+//packages dirty before the batch began are left for the user to save, unless the batch changed them itself
+//content packages are saved concurrently in chunks so progress can be shown, maps are saved one at a time
+//packages added as first are all on disk before any other package of the batch is written
+
+class FRenameDirtyPackages
+{
+public:
+
+	// remember the packages that are dirty before the batch
+	void Begin();
+
+	// a package the batch changed, saved even if it was dirty before
+	// with bFirst it is saved in a pass of its own ahead of the others, which are not saved if that pass fails
+	void Add(UPackage* Package, bool bFirst = false);
+
+	// save the packages the batch dirtied, failures are reported per package in the result
+	void Save(FRenameBatchResult& Result);
+
+private:
+
+	TSet<TObjectKey<UPackage>> DirtyBefore;
+	TSet<TObjectKey<UPackage>> Changed;
+	TSet<TObjectKey<UPackage>> First;
+};
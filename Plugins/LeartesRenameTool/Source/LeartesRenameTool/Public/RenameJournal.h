@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenameTypes.h"
+
+struct FAssetRenameData;
+class IFileHandle;
+
+//crash safe record of an asset rename batch that saves its packages, kept under the project's Saved directory
+//renames only reach the disk when the packages are saved, so the journal covers the batch from before the first
+//rename until every package was saved, a journal found at startup belongs to a batch whose save never finished
+//which items were done is read from the disk, new packages are saved before old ones, so an item is either
+//not renamed, done, or duplicated when the batch died after saving the new package but before the old one
+//a batch that does not save keeps no journal, a crash before the user saves loses nothing
+//
+//one record per line, tab separated: a header with the plan size, then P <old object path> <new package path>
+//<new name> per planned item
+
+class FRenameJournal
+{
+public:
+
+	enum class EState : uint8
+	{
+		// the new package is not on disk, the asset is still in its old package there
+		Pending,
+		// the new package is on disk but the old package still holds the asset, not a redirector
+		Duplicated,
+		// the new package is on disk and the old package is gone or a redirector
+		Done
+	};
+
+	struct FEntry
+	{
+		FString OldObjectPath;
+		FString NewPackagePath;
+		FString NewName;
+		EState State = EState::Pending;
+	};
+
+	FRenameJournal() = default;
+	~FRenameJournal();
+
+	// write and flush the plan, false if the journal could not be created
+	bool Begin(TConstArrayView<FAssetRenameData> Plan);
+
+	// every package of the batch was saved, the journal is deleted
+	void Finish();
+
+	// journal file of the batch in progress
+	static FString GetJournalPath();
+
+	// true if an earlier session left an unfinished batch behind
+	static bool HasPendingJournal();
+
+	// read the unfinished batch and check on disk which items are done, empty if unreadable
+	static TArray<FEntry> ReadPendingJournal();
+
+	// rename the items that were not renamed yet and save, the journal is deleted once everything was saved
+	// a duplicated item loses its copy in the new package and is renamed again, which saves its old package
+	// as the redirector the batch meant to write
+	static FRenameBatchResult Resume();
+
+	// rename the renamed items back to their old names and save, the journal is deleted once everything was saved
+	// a duplicated item only loses its copy in the new package, the old package already holds the asset
+	static FRenameBatchResult Rollback();
+
+	static void Discard();
+
+private:
+
+	// save what a recovery renamed, and forget the journal unless a package could not be saved
+	static void SaveRecovery(class FRenameDirtyPackages& DirtyPackages, FRenameBatchResult& Result);
+
+	void Write(const FString& Text);
+
+	IFileHandle* File = nullptr;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Change.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+
+//undo record of a batch relabel, stored in the editor transaction as one custom change
+//keeps only the actor, its old and new label and its old and new object name, which SetActorLabel may change
+//too, all labels share one character buffer, instead of the full actor snapshots Modify would serialize
+//undo and redo set the labels and names of the whole batch in one pass
+
+class FRenameLabelChange : public FCommandChange
+{
+public:
+
+	void Reserve(int32 NumActors, int32 NumChars);
+
+	void Add(AActor* Actor, FStringView OldLabel, FStringView NewLabel, FName OldName, FName NewName);
+
+	int32 Num() const { return Entries.Num(); }
+
+	virtual void Apply(UObject* Object) override;
+	virtual void Revert(UObject* Object) override;
+	virtual FString ToString() const override;
+
+private:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 OldStart = 0;
+		int32 OldLen = 0;
+		int32 NewStart = 0;
+		int32 NewLen = 0;
+		FName OldName;
+		FName NewName;
+	};
+
+	void SetLabels(bool bNew) const;
+
+	TArray<FEntry> Entries;
+	TArray<TCHAR> Labels;
+};
@@ -2,8 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "AssetRegistry/AssetData.h"
+#include "RenameNameCounts.h"
 #include "RenameTypes.h"
 
+struct FAssetRenameData;
+
 //logic to generate new names, previews and perform renaming
 //execute batch rename operations
 
@@ -13,11 +16,32 @@ public:
 	// generate a new name for a single item given the old name, rename options and index
 	static FString GenerateNewName(const FString& OldName, const FRenameOptions& Options, int32 Index);
 
+	// new names for a whole batch in input order, with intra-batch duplicates flagged or resolved
+	// invalid entries get an empty name
+	static TArray<FString> PlanAssetNames(const TArray<FAssetData>& Assets, const FRenameOptions& Options, TBitArray<>& OutDuplicates);
+	static TArray<FString> PlanActorNames(const TArray<AActor*>& Actors, const FRenameOptions& Options, TBitArray<>& OutDuplicates);
+
+	// flag planned names that repeat within a scope (package path or world, INDEX_NONE items are skipped)
+	// and with bResolve rename the later ones in place, IsTaken rejects candidates used outside the batch
+	static void ResolveBatchDuplicates(TArray<FString>& Names, const TArray<int32>& Scopes, ESearchCase::Type SearchCase, bool bResolve,
+		TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates);
+	// the same over counts the caller keeps up to date, Counts must cover exactly the scoped items of Names
+	static void ResolveBatchDuplicates(TArray<FString>& Names, const TArray<int32>& Scopes, const FRenameNameCounts& Counts, bool bResolve,
+		TFunctionRef<bool(int32, const FString&)> IsTaken, TBitArray<>& OutDuplicates);
+
 	// Generate a preview list for assets and actors
 	static TArray<FRenamePreviewItem> GeneratePreviewForAssets(const TArray<FAssetData>& Assets, const FRenameOptions& Options);
 	static TArray<FRenamePreviewItem> GeneratePreviewForActors(const TArray<AActor*>& Actors, const FRenameOptions& Options);
 
-	// actual rename operations
-	static void RenameAssetsBatch(const TArray<FAssetData>& AssetsToRename, const FRenameOptions& Options);
-	static void RenameActorsBatch(const TArray<AActor*>& ActorsToRename, const FRenameOptions& Options);
+	// AssetTools rename data for a batch, one result item per asset, failed ones already counted
+	// OutResultIndices maps every rename data entry to its result item
+	static void PlanAssetRenames(const TArray<FAssetData>& Assets, const FRenameOptions& Options, FRenameBatchResult& Result,
+		TArray<FAssetRenameData>& OutRenameData, TArray<int32>& OutResultIndices);
+
+	// actual rename operations, return the outcome of every item
+	static FRenameBatchResult RenameAssetsBatch(const TArray<FAssetData>& AssetsToRename, const FRenameOptions& Options);
+	static FRenameBatchResult RenameActorsBatch(const TArray<AActor*>& ActorsToRename, const FRenameOptions& Options);
+
+	// drop any registry rescans still queued by a deferred asset rename
+	static void CancelDeferredRegistryUpdate();
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+//how many items of each scope (package path or world) plan a name, kept by the preview between jobs
+//so a changed selection only counts the items that joined or left instead of the whole batch
+//keys view the caller's strings, which have to keep their buffers while they are counted, moving an FString is fine
+
+// fnv-1a over the characters, lowered first when the comparison ignores case
+inline uint32 GetRenameNameHash(FStringView Name, ESearchCase::Type SearchCase)
+{
+	uint32 Hash = 2166136261u;
+	for (TCHAR C : Name)
+	{
+		Hash = (Hash ^ uint32(SearchCase == ESearchCase::CaseSensitive ? C : FChar::ToLower(C))) * 16777619u;
+	}
+	return Hash;
+}
+
+class FRenameNameCounts
+{
+public:
+
+	// assets compare names ignoring case, actor labels do not
+	explicit FRenameNameCounts(ESearchCase::Type InSearchCase = ESearchCase::CaseSensitive)
+		: SearchCase(InSearchCase)
+	{
+	}
+
+	// copies would view the strings of another owner
+	FRenameNameCounts(FRenameNameCounts&&) = default;
+	FRenameNameCounts& operator=(FRenameNameCounts&&) = default;
+	FRenameNameCounts(const FRenameNameCounts&) = delete;
+	FRenameNameCounts& operator=(const FRenameNameCounts&) = delete;
+
+	ESearchCase::Type GetSearchCase() const { return SearchCase; }
+
+	void Add(int32 Scope, FStringView Name)
+	{
+		++Counts.FindOrAdd(FKey{ Scope, Name, SearchCase });
+	}
+
+	// the key keeps viewing the string it was added with, which has to outlive it unless this was the last one
+	void Remove(int32 Scope, FStringView Name)
+	{
+		const FKey Key{ Scope, Name, SearchCase };
+		int32* Count = Counts.Find(Key);
+		if (Count && --*Count <= 0)
+		{
+			Counts.Remove(Key);
+		}
+	}
+
+	int32 Num(int32 Scope, FStringView Name) const
+	{
+		const int32* Count = Counts.Find(FKey{ Scope, Name, SearchCase });
+		return Count ? *Count : 0;
+	}
+
+	void Reset() { Counts.Reset(); }
+
+private:
+
+	struct FKey
+	{
+		int32 Scope = INDEX_NONE;
+		FStringView Name;
+		ESearchCase::Type SearchCase = ESearchCase::CaseSensitive;
+	};
+
+	struct FKeyFuncs : TDefaultMapKeyFuncs<FKey, int32, false>
+	{
+		static FORCEINLINE bool Matches(const FKey& A, const FKey& B) { return A.Scope == B.Scope && A.Name.Equals(B.Name, A.SearchCase); }
+		static FORCEINLINE uint32 GetKeyHash(const FKey& Key) { return HashCombineFast(uint32(Key.Scope), GetRenameNameHash(Key.Name, Key.SearchCase)); }
+	};
+
+	ESearchCase::Type SearchCase;
+	TMap<FKey, int32, FDefaultSetAllocator, FKeyFuncs> Counts;
+};
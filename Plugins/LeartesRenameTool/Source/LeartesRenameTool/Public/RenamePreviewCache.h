@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenamePreviewJob.h"
+#include "RenamePreviewRows.h"
+#include "RenameTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UWorld;
+
+//per widget memory of earlier previews of the current selection
+//keeps the stages of the last finished preview for incremental updates, carried along as items join or leave the selection, and the rows of a few recent
+//option sets so switching back to one of them needs no job at all
+//a carried stage is handed to the next job of its kind, a job that gets cancelled takes it along and the one after starts over
+
+class FRenamePreviewCache
+{
+public:
+
+	// forget everything, called when the selection is read again from scratch
+	void Reset();
+
+	// rows of a recent finished preview with the same options, while the indexes did not change since
+	const FRenamePreviewRows* FindRows(const FRenameOptions& Options) const;
+
+	// remember the stages and rows of a job that completed
+	void Store(const FRenamePreviewJob& Job, const FRenamePreviewRows& Rows);
+
+	// carry the stage of one kind over to a changed selection, OldIndices holds for every current item its
+	// index when the stage was built, or INDEX_NONE for an item added since
+	// kept items reuse their base names, names, lookups and name counts, only the added ones are computed by the next job
+	// strings are moved out of a stage nothing else holds, a stage a job still reads is copied
+	void RemapItems(ERenameItemKind Kind, TConstArrayView<int32> OldIndices);
+
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> GetAssetStage() const { return AssetStage; }
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> GetActorStage() const { return ActorStage; }
+
+	// the stage RemapItems carried over, if any, the job that takes it finishes it in place
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> TakeCarriedStage(ERenameItemKind Kind);
+
+	// scope ids that hold until Reset, so the name counts of a carried stage stay valid for the next job
+	int32 GetAssetScope(FName PackagePath);
+	int32 GetActorScope(const UWorld* World);
+
+private:
+
+	struct FCachedRows
+	{
+		FRenameOptions Options;
+		uint32 AssetIndexVersion = 0;
+		uint32 ActorIndexVersion = 0;
+		FRenamePreviewRows Rows;
+	};
+
+	static bool HasSamePreviewOptions(const FRenameOptions& A, const FRenameOptions& B);
+
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> AssetStage;
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> ActorStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> CarriedAssetStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> CarriedActorStage;
+
+	TMap<FName, int32> AssetScopes;
+	TMap<TObjectKey<UWorld>, int32> ActorScopes;
+
+	// most recently stored last
+	TArray<FCachedRows> RecentRows;
+};
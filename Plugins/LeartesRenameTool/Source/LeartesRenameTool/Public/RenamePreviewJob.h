@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "RenameNameCounts.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "RenamePreviewRows.h"
+#include "RenameTypes.h"
+
+//background preview computation for the rename widget
+//the selection is snapshotted on the game thread, rows are built on worker threads and published
+//chunk by chunk, a job stops at the next chunk once its generation is no longer the current one
+//stages of an earlier preview of the same selection are reused where the options did not change them
+
+class FRenamePreviewCache;
+
+// late change to an already published row, produced by the duplicate pass once every name is known
+struct FRenamePreviewPatch
+{
+	int32 Row = INDEX_NONE;
+	FString NewName;
+	bool bBatchDuplicate = false;
+	// the name was replaced by a free _N variant, which never collides
+	bool bResolved = false;
+};
+
+// names and collision flags of one item kind from a finished preview, immutable once the job has finished
+// a stage carried over to a changed selection belongs to the cache, then to the next job, which finishes it in place
+struct FRenamePreviewStage
+{
+	// find/replace and case options the base names were built with
+	FString Find;
+	FString Replace;
+	TArray<FRenameReplaceRule> ReplaceRules;
+	bool bFindRegex = false;
+	bool bFindIgnoreCase = false;
+	ECaseOp CaseOp = ECaseOp::None;
+	// output of the find/replace and case steps per item, shared by every stage built on the same options
+	TSharedPtr<const TArray<FString>, ESPMode::ThreadSafe> BaseNames;
+	// items that joined the selection after the stage was built, their base names and names are still empty
+	TBitArray<> MissingBases;
+
+	// prefix, suffix and numbering options the names were composed with
+	FString Prefix;
+	FString Suffix;
+	bool bUseNumbering = false;
+	int32 StartNumber = 0;
+	int32 Padding = 0;
+
+	// full new names before the duplicate pass, and whether each was already taken in the index
+	TArray<FString> Names;
+	TArray<bool> Collisions;
+	// index version the collisions were looked up against
+	uint32 IndexVersion = 0;
+
+	// scope of every counted item, INDEX_NONE for skipped and added ones, ids come from the cache and hold across jobs
+	TArray<int32> Scopes;
+	// per scope counts of Names, keys view the strings in Names and RetiredNames
+	FRenameNameCounts NameCounts;
+	// names of items that left the selection, kept while NameCounts may still view them
+	TArray<FString> RetiredNames;
+	bool bNamesCounted = false;
+
+	bool HasSameBase(const FRenameOptions& Options, int32 NumItems) const
+	{
+		return BaseNames.IsValid() && BaseNames->Num() == NumItems && CaseOp == Options.CaseOp
+			&& Find.Equals(Options.Find, ESearchCase::CaseSensitive) && Replace.Equals(Options.Replace, ESearchCase::CaseSensitive)
+			&& ReplaceRules == Options.ReplaceRules && bFindRegex == Options.bFindRegex && bFindIgnoreCase == Options.bFindIgnoreCase;
+	}
+
+	bool HasSameCompose(const FRenameOptions& Options) const
+	{
+		return Prefix.Equals(Options.Prefix, ESearchCase::CaseSensitive) && Suffix.Equals(Options.Suffix, ESearchCase::CaseSensitive)
+			&& bUseNumbering == Options.bUseNumbering && (!bUseNumbering || (StartNumber == Options.StartNumber && Padding == Options.Padding));
+	}
+};
+
+class FRenamePreviewJob
+{
+public:
+
+	explicit FRenamePreviewJob(TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> InGeneration);
+
+	// snapshot the items and start the job, game thread only
+	// the job runs while Generation still holds the value it had at launch
+	// a stage the cache carried over to a changed selection is handed to the job
+	static TSharedRef<FRenamePreviewJob, ESPMode::ThreadSafe> Launch(const TArray<FAssetData>& Assets, const TArray<AActor*>& Actors,
+		const FRenameOptions& Options, FRenamePreviewCache& Cache, TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Generation);
+
+	// append the rows and patches published since the last call, rows arrive in preview order
+	// a row's source index counts assets first, then actors, in the order they were passed to Launch
+	// returns true once the job has finished or stopped and everything was handed out
+	bool ConsumeResults(FRenamePreviewRows& OutRows, TArray<FRenamePreviewPatch>& OutPatches);
+
+	// block until the worker has returned, a cancelled job returns after its current chunk
+	void Wait();
+
+	// true until the worker has returned
+	bool IsRunning() const { return Task.IsValid() && !Task.IsCompleted(); }
+
+	bool IsCancelled() const { return Generation->GetValue() != LaunchGeneration; }
+
+	// the following are only meaningful once ConsumeResults has returned true
+	// true if every row and patch was produced, a cancelled job leaves a partial preview
+	bool IsComplete() const { return bComplete; }
+	const FRenameOptions& GetOptions() const { return Options; }
+	uint32 GetAssetIndexVersion() const { return AssetIndexVersion; }
+	uint32 GetActorIndexVersion() const { return ActorIndexVersion; }
+	// null for a kind that was not part of the preview
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> GetAssetStage() const { return AssetStage; }
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> GetActorStage() const { return ActorStage; }
+
+private:
+
+	struct FActorItem
+	{
+		FString Label;
+		TObjectKey<UWorld> World;
+		TObjectKey<AActor> Actor;
+	};
+
+	void Run();
+
+	// build and publish the rows of one kind in waves of chunks into a new stage, returns false if the job was cancelled
+	// a carried stage with the same base options is finished in place instead, only its added items are computed
+	// GetOldName returns the current name of an item, formatting into the scratch builder if it needs to
+	// IsTaken looks a new name up in the index, it is skipped for names the previous stage already looked up
+	// SourceOffset is added to the item index to give the source index of its row
+	bool RunItems(ERenameItemKind Kind, const TArray<int32>& Scopes, int32 SourceOffset, const FRenamePreviewStage* PrevStage,
+		const TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& CarriedStage, uint32 IndexVersion, ESearchCase::Type SearchCase,
+		TFunctionRef<FStringView(int32, FNameBuilder&)> GetOldName, TFunctionRef<bool(int32, const FString&)> IsTaken,
+		TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe>& OutStage, TArray<int32>& OutRowIndices);
+
+	// flag or resolve repeated names of one kind against the stage's name counts and publish the rows that change
+	void PublishDuplicatePatches(FRenamePreviewStage& Stage, const TArray<int32>& Scopes, const TArray<int32>& RowIndices,
+		TFunctionRef<bool(int32, const FString&)> IsTaken);
+
+	// append the rows of each chunk in order
+	void Publish(TArrayView<const FRenamePreviewRows> ChunkRows);
+
+private:
+
+	FRenameOptions Options;
+
+	TArray<FAssetData> AssetItems;
+	TArray<int32> AssetScopes;
+	TArray<FActorItem> ActorItems;
+	TArray<int32> ActorScopes;
+
+	TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> Generation;
+	int32 LaunchGeneration = 0;
+
+	// stages of the previous preview, and the ones this job builds
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> PrevAssetStage;
+	TSharedPtr<const FRenamePreviewStage, ESPMode::ThreadSafe> PrevActorStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> CarriedAssetStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> CarriedActorStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> AssetStage;
+	TSharedPtr<FRenamePreviewStage, ESPMode::ThreadSafe> ActorStage;
+	uint32 AssetIndexVersion = 0;
+	uint32 ActorIndexVersion = 0;
+
+	// number of rows published so far, rows are numbered in preview order
+	int32 NumRows = 0;
+
+	FCriticalSection ResultsLock;
+	FRenamePreviewRows PendingRows;
+	TArray<FRenamePreviewPatch> PendingPatches;
+	bool bFinished = false;
+	bool bComplete = false;
+
+	UE::Tasks::FTask Task;
+};
\ No newline at end of file
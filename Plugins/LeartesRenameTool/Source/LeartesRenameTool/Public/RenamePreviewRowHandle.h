@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Views/TableViewTypeTraits.h"
+
+//list view item for a row of the widget's preview arena, a plain value instead of a shared pointer per row
+//the serial changes whenever the arena is filled with a different preview, so the list never keeps a row
+//widget that was generated for another preview's row of the same index
+
+struct FRenamePreviewRowHandle
+{
+	uint32 Serial = 0;
+	int32 Row = INDEX_NONE;
+
+	FRenamePreviewRowHandle() = default;
+	FRenamePreviewRowHandle(uint32 InSerial, int32 InRow)
+		: Serial(InSerial), Row(InRow) {}
+
+	bool IsValid() const { return Row != INDEX_NONE; }
+
+	bool operator==(const FRenamePreviewRowHandle& Other) const { return Serial == Other.Serial && Row == Other.Row; }
+	bool operator!=(const FRenamePreviewRowHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FRenamePreviewRowHandle& Handle)
+	{
+		return HashCombineFast(::GetTypeHash(Handle.Serial), ::GetTypeHash(Handle.Row));
+	}
+};
+
+// the list view only accepts pointer like items unless told otherwise, an invalid handle is the null value
+template <>
+struct TIsValidListItem<FRenamePreviewRowHandle>
+{
+	enum
+	{
+		Value = true
+	};
+};
+
+template <>
+struct TListTypeTraits<FRenamePreviewRowHandle>
+{
+public:
+	typedef FRenamePreviewRowHandle NullableType;
+
+	using MapKeyFuncs = TDefaultMapHashableKeyFuncs<FRenamePreviewRowHandle, TSharedRef<ITableRow>, false>;
+	using MapKeyFuncsSparse = TDefaultMapHashableKeyFuncs<FRenamePreviewRowHandle, FSparseItemInfo, false>;
+	using SetKeyFuncs = DefaultKeyFuncs<FRenamePreviewRowHandle>;
+
+	template<typename U>
+	static void AddReferencedObjects(FReferenceCollector&, TArray<FRenamePreviewRowHandle>&, TSet<FRenamePreviewRowHandle>&, TMap<const U*, FRenamePreviewRowHandle>&)
+	{
+	}
+
+	static bool IsPtrValid(const FRenamePreviewRowHandle& InHandle) { return InHandle.IsValid(); }
+	static void ResetPtr(FRenamePreviewRowHandle& InHandle) { InHandle = FRenamePreviewRowHandle(); }
+	static FRenamePreviewRowHandle MakeNullPtr() { return FRenamePreviewRowHandle(); }
+	static FRenamePreviewRowHandle NullableItemTypeConvertToItemType(const FRenamePreviewRowHandle& InHandle) { return InHandle; }
+	static FString DebugDump(const FRenamePreviewRowHandle& InHandle) { return FString::Printf(TEXT("Row %d (serial %u)"), InHandle.Row, InHandle.Serial); }
+
+	class SerializerType {};
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+#include "RenameTypes.h"
+
+//rules files of the headless rename commandlets, a json object with a list of rules applied in order
+//every field but paths is optional and defaults like FRenameOptions:
+//{ "rules": [ { "name": "Static meshes", "paths": ["/Game/Props"], "recursivePaths": true,
+//               "classes": ["/Script/Engine.StaticMesh"], "recursiveClasses": false,
+//               "prefix": "SM_", "suffix": "", "find": "", "replace": "", "case": "None",
+//               "regex": false, "ignoreCase": false,
+//               "replaceRules": [ { "find": "Tex_", "replace": "T_" }, { "find": "Blueprint", "replace": "BP" } ],
+//               "useNumbering": false, "startNumber": 1, "padding": 2,
+//               "resolveDuplicates": true, "bulkChunkSize": 0, "fixupRedirectors": false } ] }
+//case is one of None, Upper, Lower, CapitalizeFirst, PascalCase, snake_case, camelCase or Title_Case
+//fixupRedirectors saves the referencing packages, -NoSave turns it off and notes that in the report
+
+// one entry of a rules file, the items it matches and the options applied to them
+struct FRenameRule
+{
+	FString Name;
+	// content paths the rule covers, only used by asset rules
+	TArray<FName> Paths;
+	bool bRecursivePaths = true;
+	// classes the rule is limited to, every class if empty
+	TArray<FTopLevelAssetPath> Classes;
+	bool bRecursiveClasses = false;
+	FRenameOptions Options;
+};
+
+namespace RenameRules
+{
+	// read every rule of the file, logs and returns false on the first problem
+	// asset rules need a content path, without one a rule would match the whole registry
+	bool LoadFromFile(const FString& Path, bool bRequirePaths, TArray<FRenameRule>& OutRules);
+}
@@ -3,7 +3,15 @@
 #include "Widgets/SCompoundWidget.h"
 #include "RenameTypes.h"
 #include "RenameLogic.h"
+#include "RenamePreviewCache.h"
+#include "RenamePreviewJob.h"
+#include "RenamePreviewRowHandle.h"
+#include "RenamePreviewRows.h"
+#include "RenamePreviewView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Engine/TimerHandle.h"
 #include "AssetRegistry/AssetData.h"
+#include "UObject/ObjectKey.h"
 
 //main slate widget for the rename tool
 
@@ -15,20 +23,30 @@ public:
 
     void Construct(const FArguments& InArgs);
 
+    virtual ~SLeartesRenameWidget();
+
 private:
     // UI widgets
     TSharedPtr<class SEditableTextBox> PrefixTextBox;
     TSharedPtr<class SEditableTextBox> SuffixTextBox;
     TSharedPtr<class SEditableTextBox> FindTextBox;
     TSharedPtr<class SEditableTextBox> ReplaceTextBox;
+    TSharedPtr<class SMultiLineEditableTextBox> ReplaceRulesTextBox;
     TSharedPtr<class SCheckBox> AssetsCheckBox;
     TSharedPtr<class SCheckBox> ActorsCheckBox;
     TSharedPtr<class SCheckBox> DryRunCheckBox;
+    TSharedPtr<class SCheckBox> FixupRedirectorsCheckBox;
+    TSharedPtr<class SCheckBox> SaveOnApplyCheckBox;
     TSharedPtr<class SCheckBox> UseNumberingCheckBox;
+    TSharedPtr<class SCheckBox> ResolveDuplicatesCheckBox;
+    TSharedPtr<class SCheckBox> RegexCheckBox;
+    TSharedPtr<class SCheckBox> IgnoreCaseCheckBox;
     TSharedPtr<class SNumericEntryBox<int32>> StartNumberEntry;
     TSharedPtr<class SNumericEntryBox<int32>> PaddingEntry;
     TSharedPtr<class STextComboBox> CaseComboBox;
-    TSharedPtr<class SListView<TSharedPtr<FRenamePreviewItem>>> PreviewListView;
+    TSharedPtr<class SListView<FRenamePreviewRowHandle>> PreviewListView;
+    TSharedPtr<class SCheckBox> ProblemsOnlyCheckBox;
+    TSharedPtr<class STextBlock> PreviewCountText;
 
     // Visible selection count texts
     TSharedPtr<class STextBlock> AssetsCountText;
@@ -45,20 +63,85 @@ private:
     TArray<TSharedPtr<FString>> CaseOptionsList;
     TSharedPtr<FString> SelectedCaseItem;
 
-    //cached selection arrays
+    //cached selection arrays, kept up to date by the content browser and editor selection events
+    //an item that leaves the selection leaves a gap (invalid asset data, null actor) until the next compaction
     TArray<FAssetData> CachedSelectedAssets;
     TArray<AActor*> CachedSelectedActors;
-    TArray<TSharedPtr<FRenamePreviewItem>> PreviewItems;
+    //slot of every selected item in the arrays above
+    TMap<FSoftObjectPath, int32> SelectedAssetSlots;
+    TMap<TObjectKey<AActor>, int32> SelectedActorSlots;
+    //per slot, the index the item had when the cached preview stages were built, INDEX_NONE if it joined later
+    TArray<int32> AssetSlotOrigins;
+    TArray<int32> ActorSlotOrigins;
+    bool bAssetSlotsChanged = false;
+    bool bActorSlotsChanged = false;
+    FDelegateHandle AssetSelectionChangedHandle;
+    FDelegateHandle ActorSelectObjectHandle;
+    FDelegateHandle ActorSelectNoneHandle;
+    FDelegateHandle ActorSelectionChangedHandle;
+    //rows of the current preview, and one list handle per row
+    FRenamePreviewRows PreviewRows;
+    //rows handed over by the job each frame, kept to reuse its allocations
+    FRenamePreviewRows IncomingPreviewRows;
+    TArray<FRenamePreviewRowHandle> PreviewItems;
+    uint32 PreviewRowsSerial = 0;
+
+    //sort column and filter of the preview list, the view keeps the column orders between rebuilds
+    FRenamePreviewView PreviewView;
+    TArray<int32> PreviewOrder;
+    ERenamePreviewColumn PreviewSortColumn = ERenamePreviewColumn::None;
+    bool bPreviewSortDescending = false;
+    bool bPreviewProblemsOnly = false;
+
+    //highlighted old and new names of the rows that came into view, by row, dropped with the rows
+    TMap<int32, TPair<FText, FText>> PreviewDiffTexts;
+
+    //background preview, bumping the generation stops the running job at its next chunk
+    TSharedRef<FThreadSafeCounter, ESPMode::ThreadSafe> PreviewGeneration = MakeShared<FThreadSafeCounter, ESPMode::ThreadSafe>();
+    TSharedPtr<FRenamePreviewJob, ESPMode::ThreadSafe> PreviewJob;
+    //cancelled jobs that may still be inside their current chunk, the destructor waits for them as well
+    TArray<TSharedPtr<FRenamePreviewJob, ESPMode::ThreadSafe>> CancelledPreviewJobs;
+    TSharedPtr<FActiveTimerHandle> PreviewPollTimer;
+    //rows on screen belong to an older preview until the running job publishes its first rows
+    bool bReplacePreviewRows = false;
+
+    //stages and recent results reused by later previews of the same selection
+    FRenamePreviewCache PreviewCache;
+    //live preview waits for a short pause in typing
+    FTimerHandle LivePreviewTimer;
 
     //callbacks and actions
     FReply OnApplyClicked();
     FReply OnRefreshClicked();
     FReply OnCancelClicked();
     void OnUseNumberingChanged(ECheckBoxState NewState);
+    void OnOptionTextChanged(const FText& NewText);
+    void OnOptionCheckChanged(ECheckBoxState NewState);
+
+    //selection tracking
+    void OnAssetSelectionChanged(const TArray<FAssetData>& NewSelectedAssets, bool bIsPrimaryBrowser);
+    void OnActorSelectObject(UObject* Object);
+    void OnActorSelectNone();
+    void OnActorSelectionChanged(UObject* Selection);
+    bool AddSelectedAsset(const FAssetData& Asset);
+    bool AddSelectedActor(AActor* Actor);
+    void OnSelectionDelta();
+    void CompactSelection();
 
     //update ui and previews
     void RefreshSelection();
+    void UpdateOptionsFromUI();
     void RefreshPreview();
-    TSharedRef<ITableRow> OnGenerateRowForPreview(TSharedPtr<FRenamePreviewItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
+    void CancelPreviewJob();
+    void ScheduleLivePreview();
+    EActiveTimerReturnType PollPreviewJob(double InCurrentTime, float InDeltaTime);
+    void RebuildPreviewItems();
+    void AppendPreviewItems(int32 FirstRow);
+    void UpdatePreviewCountText();
+    EColumnSortMode::Type GetPreviewSortMode(ERenamePreviewColumn Column) const;
+    void OnPreviewSortChanged(EColumnSortPriority::Type Priority, const FName& ColumnId, EColumnSortMode::Type NewSortMode);
+    void OnProblemsOnlyChanged(ECheckBoxState NewState);
+    TSharedRef<ITableRow> OnGenerateRowForPreview(FRenamePreviewRowHandle Item, const TSharedRef<STableViewBase>& OwnerTable);
+    const TPair<FText, FText>& GetPreviewDiffTexts(int32 Row);
     void UpdateSelectionCounts();
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// console program running the rename name kernel microbenchmarks without an editor
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class LeartesRenameBenchTarget : TargetRules
+{
+	public LeartesRenameBenchTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_5;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "LeartesRenameBench";
+
+		// only the Core based kernel module of the plugin is compatible with programs
+		EnablePlugins.Add("LeartesRenameTool");
+
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		// core's regex matcher is built on icu, without it the regex cases would compare two non working matchers
+		bCompileICU = true;
+		bIsBuildingConsoleApplication = true;
+	}
+}
@@ -0,0 +1,495 @@
+#include "CoreMinimal.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "RenameNamePlan.h"
+#include "RenameNameDiff.h"
+#include "RenameNameReference.h"
+#include "RenamePreviewRows.h"
+#include "RenamePreviewView.h"
+#include "RenameTypes.h"
+
+//microbenchmarks for the rename name kernels, linked against Core only so a run takes seconds
+//usage: LeartesRenameBench [-Count=1000000] [-Seed=1234] [-Corpus=names.txt]
+//a corpus file holds one name per line, e.g. exported from a real project, otherwise names are synthesized
+
+IMPLEMENT_APPLICATION(LeartesRenameBench, "LeartesRenameBench");
+
+namespace NameKernelBench
+{
+	// asset and actor style stems of mixed length, some non ascii as found in localized projects
+	static const TCHAR* Stems[] =
+	{
+		TEXT("SM_Rock"), TEXT("Tex_Ground_Diffuse"), TEXT("Mat_Wall_Brick_Old"), TEXT("BP_Door"), TEXT("Chair"),
+		TEXT("SK_Mannequin_Arms_Long"), TEXT("Fx_Smoke_Plume_Large_Dense"), TEXT("Lamp"), TEXT("A"),
+		TEXT("Stra\u00DFe_Schild"), TEXT("\u00C4mter_Geb\u00E4ude"), TEXT("Ch\u00E2teau_Tour"),
+		TEXT("\u0414\u043E\u043C_\u041A\u0438\u0440\u043F\u0438\u0447"), TEXT("\u6771\u4EAC_\u30BF\u30EF\u30FC"), TEXT("\u03A9mega_\u0394elta")
+	};
+
+	static const TCHAR* Parts[] =
+	{
+		TEXT("_LOD0"), TEXT("_Variant"), TEXT("_Damaged"), TEXT("_Interior_Night"), TEXT("_\u00DCbergang"), TEXT("_01")
+	};
+
+	static TArray<FString> MakeCorpus(int32 Count, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<FString> Names;
+		Names.Reserve(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			FString Name = Stems[Random.RandHelper(UE_ARRAY_COUNT(Stems))];
+			for (int32 PartCount = Random.RandRange(0, 4); PartCount > 0; --PartCount)
+			{
+				Name += Parts[Random.RandHelper(UE_ARRAY_COUNT(Parts))];
+			}
+			Name += FString::Printf(TEXT("_%d"), Random.RandRange(0, 99999));
+			Names.Add(MoveTemp(Name));
+		}
+		return Names;
+	}
+
+	// cycles the file lines up to Count names so every run works on the same amount of data
+	static bool LoadCorpus(const FString& Path, int32 Count, TArray<FString>& OutNames)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+		{
+			return false;
+		}
+		Lines.RemoveAll([](const FString& Line) { return Line.TrimStartAndEnd().IsEmpty(); });
+		if (Lines.Num() == 0)
+		{
+			return false;
+		}
+
+		OutNames.Reset(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutNames.Add(Lines[i % Lines.Num()].TrimStartAndEnd());
+		}
+		return true;
+	}
+
+	static const TCHAR* LexCaseOp(ECaseOp Op)
+	{
+		switch (Op)
+		{
+		case ECaseOp::Upper: return TEXT("upper");
+		case ECaseOp::Lower: return TEXT("lower");
+		case ECaseOp::CapitalizeFirst: return TEXT("capfirst");
+		case ECaseOp::PascalCase: return TEXT("pascal");
+		case ECaseOp::SnakeCase: return TEXT("snake");
+		case ECaseOp::CamelCase: return TEXT("camel");
+		case ECaseOp::TitleCase: return TEXT("title");
+		default: return TEXT("none");
+		}
+	}
+
+	// every combination of find, case and numbering, always with a prefix and suffix
+	// returns the number of names where the plan differs from the reference
+	static int32 RunAll(const TArray<FString>& Corpus)
+	{
+		const ECaseOp CaseOps[] =
+		{
+			ECaseOp::None, ECaseOp::Upper, ECaseOp::Lower, ECaseOp::CapitalizeFirst,
+			ECaseOp::PascalCase, ECaseOp::SnakeCase, ECaseOp::CamelCase, ECaseOp::TitleCase
+		};
+		const int32 Count = Corpus.Num();
+		int32 TotalMismatches = 0;
+
+		UE_LOG(LogTemp, Display, TEXT("%-6s %-9s %-7s %12s %12s %12s %8s %10s"),
+			TEXT("find"), TEXT("case"), TEXT("number"), TEXT("legacy ns"), TEXT("plan ns"), TEXT("reused ns"), TEXT("speedup"), TEXT("mismatch"));
+
+		for (int32 bFind = 0; bFind < 2; ++bFind)
+		{
+			for (ECaseOp CaseOp : CaseOps)
+			{
+				for (int32 bNumber = 0; bNumber < 2; ++bNumber)
+				{
+					FRenameOptions Options;
+					Options.Prefix = TEXT("P_");
+					Options.Suffix = TEXT("_S");
+					Options.Find = bFind ? TEXT("_") : TEXT("");
+					Options.Replace = TEXT("-");
+					Options.CaseOp = CaseOp;
+					Options.bUseNumbering = bNumber != 0;
+					Options.Padding = 4;
+
+					int64 Checksum = 0;
+
+					double Start = FPlatformTime::Seconds();
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Checksum += RenameNameReference::GenerateNewName(Corpus[i], Options, i).Len();
+					}
+					const double LegacySeconds = FPlatformTime::Seconds() - Start;
+
+					Start = FPlatformTime::Seconds();
+					const FRenameNamePlan Plan(Options);
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Checksum += Plan.Generate(Corpus[i], i).Len();
+					}
+					const double PlanSeconds = FPlatformTime::Seconds() - Start;
+
+					Start = FPlatformTime::Seconds();
+					FString Buffer;
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Plan.Generate(Corpus[i], i, Buffer);
+						Checksum += Buffer.Len();
+					}
+					const double ReusedSeconds = FPlatformTime::Seconds() - Start;
+
+					// every name is checked, the reference is the specification of the output
+					int32 Mismatches = 0;
+					for (int32 i = 0; i < Count; ++i)
+					{
+						Plan.Generate(Corpus[i], i, Buffer);
+						if (!Buffer.Equals(RenameNameReference::GenerateNewName(Corpus[i], Options, i), ESearchCase::CaseSensitive))
+						{
+							Mismatches++;
+						}
+					}
+					TotalMismatches += Mismatches;
+
+					const double NsPerName = 1e9 / Count;
+					UE_LOG(LogTemp, Display, TEXT("%-6s %-9s %-7s %12.1f %12.1f %12.1f %7.1fx %10d  (checksum %lld)"),
+						bFind ? TEXT("yes") : TEXT("no"), LexCaseOp(CaseOp), bNumber ? TEXT("yes") : TEXT("no"),
+						LegacySeconds * NsPerName, PlanSeconds * NsPerName, ReusedSeconds * NsPerName,
+						LegacySeconds / FMath::Max(PlanSeconds, 1e-9), Mismatches, Checksum);
+				}
+			}
+		}
+
+		return TotalMismatches;
+	}
+
+	// replace tables of growing size, rules are substrings of the corpus so a good share of them match
+	// the plan should cost about the same per name for 1 and for 100 rules
+	static int32 RunReplaceTables(const TArray<FString>& Corpus, int32 Seed)
+	{
+		const int32 RuleCounts[] = { 1, 3, 10, 30, 100 };
+		const int32 Count = Corpus.Num();
+		int32 TotalMismatches = 0;
+
+		FRandomStream Random(Seed);
+		TArray<FRenameReplaceRule> AllRules = { { TEXT("Tex_"), TEXT("T_") }, { TEXT("Mat"), TEXT("M_") }, { TEXT("Blueprint"), TEXT("BP") } };
+		while (AllRules.Num() < RuleCounts[UE_ARRAY_COUNT(RuleCounts) - 1])
+		{
+			const FString& Name = Corpus[Random.RandHelper(Count)];
+			const int32 Len = FMath::Min(Name.Len(), Random.RandRange(2, 6));
+			const int32 Start = Random.RandRange(0, Name.Len() - Len);
+			AllRules.Add({ Name.Mid(Start, Len), FString::Printf(TEXT("R%d"), AllRules.Num()) });
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("%-6s %12s %12s %8s %10s"), TEXT("rules"), TEXT("legacy ns"), TEXT("plan ns"), TEXT("speedup"), TEXT("mismatch"));
+
+		for (int32 RuleCount : RuleCounts)
+		{
+			FRenameOptions Options;
+			Options.bUseNumbering = false;
+			Options.Find = AllRules[0].Find;
+			Options.Replace = AllRules[0].Replace;
+			Options.ReplaceRules.Append(AllRules.GetData() + 1, RuleCount - 1);
+
+			int64 Checksum = 0;
+
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Checksum += RenameNameReference::GenerateNewName(Corpus[i], Options, i).Len();
+			}
+			const double LegacySeconds = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			const FRenameNamePlan Plan(Options);
+			FString Buffer;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plan.Generate(Corpus[i], i, Buffer);
+				Checksum += Buffer.Len();
+			}
+			const double PlanSeconds = FPlatformTime::Seconds() - Start;
+
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plan.Generate(Corpus[i], i, Buffer);
+				if (!Buffer.Equals(RenameNameReference::GenerateNewName(Corpus[i], Options, i), ESearchCase::CaseSensitive))
+				{
+					Mismatches++;
+				}
+			}
+			TotalMismatches += Mismatches;
+
+			const double NsPerName = 1e9 / Count;
+			UE_LOG(LogTemp, Display, TEXT("%-6d %12.1f %12.1f %7.1fx %10d  (checksum %lld)"),
+				RuleCount, LegacySeconds * NsPerName, PlanSeconds * NsPerName, LegacySeconds / FMath::Max(PlanSeconds, 1e-9), Mismatches, Checksum);
+		}
+
+		return TotalMismatches;
+	}
+
+	// regex find/replace, one pattern with a literal most names lack and one every name goes through the engine for
+	static int32 RunRegexes(const TArray<FString>& Corpus)
+	{
+#if UE_ENABLE_ICU
+		struct FRegexCase
+		{
+			const TCHAR* Find;
+			const TCHAR* Replace;
+			bool bIgnoreCase;
+		};
+		const FRegexCase Cases[] =
+		{
+			{ TEXT("^(SM|SK)_(.*)_LOD\\d+$"), TEXT("$1_$2"), false },
+			{ TEXT("_damaged"), TEXT("_Broken"), true },
+			{ TEXT("_(\\w)\\w*$"), TEXT("_${1}x"), false }
+		};
+
+		const int32 Count = Corpus.Num();
+		int32 TotalMismatches = 0;
+
+		UE_LOG(LogTemp, Display, TEXT("%-28s %12s %12s %8s %10s"), TEXT("regex"), TEXT("legacy ns"), TEXT("plan ns"), TEXT("speedup"), TEXT("mismatch"));
+
+		for (const FRegexCase& Case : Cases)
+		{
+			FRenameOptions Options;
+			Options.bUseNumbering = false;
+			Options.Find = Case.Find;
+			Options.Replace = Case.Replace;
+			Options.bFindRegex = true;
+			Options.bFindIgnoreCase = Case.bIgnoreCase;
+
+			int64 Checksum = 0;
+
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Checksum += RenameNameReference::GenerateNewName(Corpus[i], Options, i).Len();
+			}
+			const double LegacySeconds = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			const FRenameNamePlan Plan(Options);
+			FString Buffer;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plan.Generate(Corpus[i], i, Buffer);
+				Checksum += Buffer.Len();
+			}
+			const double PlanSeconds = FPlatformTime::Seconds() - Start;
+
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Plan.Generate(Corpus[i], i, Buffer);
+				if (!Buffer.Equals(RenameNameReference::GenerateNewName(Corpus[i], Options, i), ESearchCase::CaseSensitive))
+				{
+					Mismatches++;
+				}
+			}
+			TotalMismatches += Mismatches;
+
+			const double NsPerName = 1e9 / Count;
+			UE_LOG(LogTemp, Display, TEXT("%-28s %12.1f %12.1f %7.1fx %10d  (checksum %lld)"),
+				Case.Find, LegacySeconds * NsPerName, PlanSeconds * NsPerName, LegacySeconds / FMath::Max(PlanSeconds, 1e-9), Mismatches, Checksum);
+		}
+
+		return TotalMismatches;
+#else
+		// both sides would run on a matcher that never matches and agree trivially
+		UE_LOG(LogTemp, Display, TEXT("regex: skipped, this build has no icu and core's regex matcher needs it"));
+		return 0;
+#endif
+	}
+
+	// sorting and filtering a preview of the whole corpus, one in a thousand rows collides
+	// returns the number of adjacent rows found out of order
+	static int32 RunPreviewView(const TArray<FString>& Corpus, int32 Seed)
+	{
+		FRenameOptions Options;
+		Options.Prefix = TEXT("P_");
+		Options.bUseNumbering = true;
+		const FRenameNamePlan Plan(Options);
+
+		FRandomStream Random(Seed);
+		FRenamePreviewRows Rows;
+		FString NewName;
+		for (int32 i = 0; i < Corpus.Num(); ++i)
+		{
+			Plan.Generate(Corpus[i], i, NewName);
+			Rows.Add(Corpus[i], NewName, Random.RandHelper(1000) == 0, Random.RandHelper(4) == 0 ? ERenameItemKind::Actor : ERenameItemKind::Asset, i);
+		}
+
+		struct FViewCase
+		{
+			const TCHAR* Label;
+			ERenamePreviewColumn Column;
+			bool bDescending;
+			bool bProblemsOnly;
+		};
+		const FViewCase Cases[] =
+		{
+			{ TEXT("old name"), ERenamePreviewColumn::OldName, false, false },
+			{ TEXT("old name desc"), ERenamePreviewColumn::OldName, true, false },
+			{ TEXT("new name"), ERenamePreviewColumn::NewName, false, false },
+			{ TEXT("status desc"), ERenamePreviewColumn::Status, true, false },
+			{ TEXT("kind"), ERenamePreviewColumn::Kind, false, false },
+			{ TEXT("old name, problems"), ERenamePreviewColumn::OldName, false, true },
+			{ TEXT("unsorted, problems"), ERenamePreviewColumn::None, false, true }
+		};
+
+		UE_LOG(LogTemp, Display, TEXT("%-20s %12s %12s %10s %10s  (arena %.1f MB)"),
+			TEXT("preview view"), TEXT("first ms"), TEXT("again ms"), TEXT("rows"), TEXT("unordered"), Rows.GetAllocatedSize() / (1024.0 * 1024.0));
+
+		FRenamePreviewView View;
+		TArray<int32> Order;
+		int32 TotalUnordered = 0;
+		for (const FViewCase& Case : Cases)
+		{
+			// the first build may sort the column, later ones reuse its order
+			double Start = FPlatformTime::Seconds();
+			View.Build(Rows, Case.Column, Case.bDescending, Case.bProblemsOnly, Order);
+			const double FirstSeconds = FPlatformTime::Seconds() - Start;
+
+			Start = FPlatformTime::Seconds();
+			View.Build(Rows, Case.Column, Case.bDescending, Case.bProblemsOnly, Order);
+			const double AgainSeconds = FPlatformTime::Seconds() - Start;
+
+			int32 Unordered = 0;
+			for (int32 i = 1; i < Order.Num(); ++i)
+			{
+				const int32 A = Case.bDescending ? Order[i] : Order[i - 1];
+				const int32 B = Case.bDescending ? Order[i - 1] : Order[i];
+				int32 Compare = 0;
+				switch (Case.Column)
+				{
+				case ERenamePreviewColumn::OldName: Compare = FRenamePreviewView::CompareNames(Rows.GetOldName(A), Rows.GetOldName(B)); break;
+				case ERenamePreviewColumn::NewName: Compare = FRenamePreviewView::CompareNames(Rows.GetNewName(A), Rows.GetNewName(B)); break;
+				case ERenamePreviewColumn::Status: Compare = int32(Rows.IsCollision(A)) - int32(Rows.IsCollision(B)); break;
+				case ERenamePreviewColumn::Kind: Compare = int32(Rows.GetKind(A)) - int32(Rows.GetKind(B)); break;
+				default: break;
+				}
+				if (Compare > 0 || (Compare == 0 && A > B))
+				{
+					Unordered++;
+				}
+			}
+			TotalUnordered += Unordered;
+
+			UE_LOG(LogTemp, Display, TEXT("%-20s %12.2f %12.2f %10d %10d"), Case.Label, FirstSeconds * 1e3, AgainSeconds * 1e3, Order.Num(), Unordered);
+		}
+
+		return TotalUnordered;
+	}
+
+	// diffs of every old and new name pair, the widget only computes them for rows in view
+	// returns the number of diffs that do not cover both names or mark differing text as equal
+	static int32 RunNameDiffs(const TArray<FString>& Corpus)
+	{
+		FRenameOptions Options;
+		Options.Prefix = TEXT("P_");
+		Options.Find = TEXT("_");
+		Options.Replace = TEXT("");
+		Options.CaseOp = ECaseOp::SnakeCase;
+		Options.bUseNumbering = true;
+		const FRenameNamePlan Plan(Options);
+
+		TArray<FString> NewNames;
+		NewNames.SetNum(Corpus.Num());
+		for (int32 i = 0; i < Corpus.Num(); ++i)
+		{
+			Plan.Generate(Corpus[i], i, NewNames[i]);
+		}
+
+		int64 NumSpans = 0;
+		int32 Invalid = 0;
+		FRenameNameDiff Spans;
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Corpus.Num(); ++i)
+		{
+			RenameNameDiff::Compute(Corpus[i], NewNames[i], Spans);
+			NumSpans += Spans.Num();
+		}
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		for (int32 i = 0; i < Corpus.Num(); ++i)
+		{
+			const FStringView OldName = Corpus[i];
+			const FStringView NewName = NewNames[i];
+			RenameNameDiff::Compute(OldName, NewName, Spans);
+
+			int32 OldEnd = 0;
+			int32 NewEnd = 0;
+			bool bValid = true;
+			for (const FRenameDiffSpan& Span : Spans)
+			{
+				bValid &= Span.OldStart == OldEnd && Span.NewStart == NewEnd;
+				bValid &= Span.Op != ERenameDiffOp::Equal || OldName.Mid(Span.OldStart, Span.OldLen).Equals(NewName.Mid(Span.NewStart, Span.NewLen), ESearchCase::CaseSensitive);
+				OldEnd += Span.OldLen;
+				NewEnd += Span.NewLen;
+			}
+			if (!bValid || OldEnd != OldName.Len() || NewEnd != NewName.Len())
+			{
+				Invalid++;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("name diff: %.1f ns per row, %.2f spans per row, %d invalid"),
+			Seconds * 1e9 / Corpus.Num(), double(NumSpans) / Corpus.Num(), Invalid);
+		return Invalid;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("LeartesRenameBench exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Ret;
+	}
+
+	int32 Count = 1000000;
+	int32 Seed = 1234;
+	FString CorpusPath;
+	FParse::Value(FCommandLine::Get(), TEXT("-Count="), Count);
+	FParse::Value(FCommandLine::Get(), TEXT("-Seed="), Seed);
+	FParse::Value(FCommandLine::Get(), TEXT("-Corpus="), CorpusPath);
+	Count = FMath::Max(1, Count);
+
+	TArray<FString> Corpus;
+	if (!CorpusPath.IsEmpty())
+	{
+		if (!NameKernelBench::LoadCorpus(CorpusPath, Count, Corpus))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not read any names from %s"), *CorpusPath);
+			return 1;
+		}
+	}
+	else
+	{
+		Corpus = NameKernelBench::MakeCorpus(Count, Seed);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Name kernel benchmark over %d names"), Corpus.Num());
+	const int32 Mismatches = NameKernelBench::RunAll(Corpus) + NameKernelBench::RunReplaceTables(Corpus, Seed)
+		+ NameKernelBench::RunRegexes(Corpus) + NameKernelBench::RunPreviewView(Corpus, Seed)
+		+ NameKernelBench::RunNameDiffs(Corpus);
+
+	// a mismatch means the plan no longer reproduces the reference output, the preview view misplaced a row or a diff is inconsistent
+	return Mismatches == 0 ? 0 : 1;
+}